@@ -1,163 +1,328 @@
-/*
- ****************************************************************************
- *
- *                  UNIVERSITY OF WATERLOO ECE350 RTX LAB  
- *
- *                     Copyright 2020-2022 Yiqing Huang
- *                          All rights reserved.
- *---------------------------------------------------------------------------
- *  Redistribution and use in source and binary forms, with or without
- *  modification, are permitted provided that the following conditions are met:
- *  - Redistributions of source code must retain the above copyright
- *    notice and the following disclaimer.
- *
- *
- *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
- *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
- *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
- *  ARE DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS AND CONTRIBUTORS BE
- *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
- *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
- *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
- *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
- *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
- *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
- *  POSSIBILITY OF SUCH DAMAGE.
- *---------------------------------------------------------------------------*/
- 
-
-/**************************************************************************//**
- * @file        HAL.c
- * @brief       Hardware Abstraction Layer 
- *              
- * @version     V1.2022.05
- * @authors     Yiqing Huang
- * @date        2022 MAY
- * @note        This file contains embedded assembly. 
- *              The code borrowed some ideas from ARM RL-RTX source code
- *
- *****************************************************************************/
-
-#include "k_rtx.h"
-#include "k_inc.h"
-
-/**************************************************************************//**
- * @brief   	pop off exception stack frame from the stack
- * @pre         PSP is used in thread mode before entering any exception
- *              SVC_Handler is configured as the highest interrupt priority
- *****************************************************************************/
-__asm void __rte(void)
-{
-    PRESERVE8
-    EXPORT  SVC_RTE
-SVC_RTE
-    MVN     LR, #:NOT:0xFFFFFFFD    // set EXC_RETURN value, Thread mode, PSP
-    BX      LR    
-    ALIGN
-}
-
-/**************************************************************************//**
- * @brief   	SVC Handler
- * @pre         PSP is used in thread mode before entering SVC Handler
- *              SVC_Handler is configured as the highest interrupt priority
- *****************************************************************************/
-
-void SVC_Handler(void)
-{
-    
-    U8   svc_number;
-    U32  ret  = RTX_OK;                 // default return value of a function
-    U32 *args = (U32 *) __get_PSP();    // read PSP to get stacked args
-    
-    svc_number = ((S8 *) args[6])[-2];  // Memory[(Stacked PC) - 2]
-    switch(svc_number) {
-        case SVC_RTX_INIT:
-            ret = k_rtx_init((RTX_SYS_INFO*) args[0], (TASK_INIT *) args[1], (int) args[2]);
-            break;
-        case SVC_MEM_ALLOC:
-            ret = (U32) k_mpool_alloc(MPID_IRAM1, (size_t) args[0]);
-            break;
-        case SVC_MEM_DEALLOC:
-            ret = k_mpool_dealloc(MPID_IRAM1, (void *)args[0]);
-            break;
-        case SVC_MEM_DUMP:
-            ret = k_mpool_dump(MPID_IRAM1);
-            break;
-        case SVC_TSK_CREATE:
-            ret = k_tsk_create((task_t *)(args[0]), (void (*)(void))(args[1]), (U8)(args[2]), (U32) (args[3]));
-            break;
-        case SVC_TSK_EXIT:
-            k_tsk_exit();
-            break;
-        case SVC_TSK_YIELD:
-            ret = k_tsk_yield();
-            break;
-        case SVC_TSK_SET_PRIO:
-            ret = k_tsk_set_prio((task_t) args[0], (U8) args[1]);
-            break;
-        case SVC_TSK_GET:
-            ret = k_tsk_get((task_t ) args[0], (RTX_TASK_INFO *) args[1]);
-            break;
-        case SVC_TSK_GETTID:
-            ret = k_tsk_gettid();
-            break;
-        case SVC_TSK_LS:
-            ret = k_tsk_ls((task_t *) args[0], (size_t) args[1]);
-            break;
-        case SVC_MBX_CREATE:
-            ret = k_mbx_create((size_t) args[0]);
-            break;
-        case SVC_MBX_SEND:
-            ret = k_send_msg((task_t) args[0], (const void *) args[1]);
-            break;
-        case SVC_MBX_SEND_NB:
-            ret = k_send_msg_nb((task_t) args[0], (const void *) args[1]);
-            break;
-        case SVC_MBX_RECV:
-            ret = k_recv_msg((void *) args[0], (size_t) args[1]);
-            break;
-        case SVC_MBX_RECV_NB:
-            ret = k_recv_msg_nb((void *) args[0], (size_t) args[1]);
-            break;
-        case SVC_MBX_LS:
-            ret = k_mbx_ls((task_t *) args[0], (size_t) args[1]);
-            break;
-        case SVC_MBX_GET:
-            ret = k_mbx_get((task_t) args[0]);
-            break;
-        case SVC_RT_TSK_SET:
-            ret = k_rt_tsk_set((TIMEVAL*) args[0]);
-            break;
-        case SVC_RT_TSK_SUSP:
-            ret = k_rt_tsk_susp();
-            break;
-        case SVC_RT_TSK_GET:
-            ret = k_rt_tsk_get((task_t) args[0], (TIMEVAL *) args[1]);
-            break;
-#ifdef ECE350_P1
-        // The following are only for P1 memory testing purpose
-        // Future deliverables do not provide the following sys calls to tasks
-        case SVC_MEM2_ALLOC:
-            ret = (U32) k_mpool_alloc(MPID_IRAM2, (size_t) args[0]);
-            break;
-        case SVC_MEM2_DEALLOC:
-            ret = k_mpool_dealloc(MPID_IRAM2, (void *)args[0]);
-            break;
-        case SVC_MEM2_DUMP:
-            ret = k_mpool_dump(MPID_IRAM2);
-            break;
-#endif
-        default:
-            ret = (U32) RTX_ERR;
-    }
-    
-    args[0] = ret;      // return value saved onto the stacked R0
-}
-
-
-/*
- *===========================================================================
- *                             END OF FILE
- *===========================================================================
- */
-
+/*
+ ****************************************************************************
+ *
+ *                  UNIVERSITY OF WATERLOO ECE350 RTX LAB  
+ *
+ *                     Copyright 2020-2022 Yiqing Huang
+ *                          All rights reserved.
+ *---------------------------------------------------------------------------
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice and the following disclaimer.
+ *
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS AND CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *---------------------------------------------------------------------------*/
+ 
+
+/**************************************************************************//**
+ * @file        HAL.c
+ * @brief       Hardware Abstraction Layer 
+ *              
+ * @version     V1.2022.05
+ * @authors     Yiqing Huang
+ * @date        2022 MAY
+ * @note        This file contains embedded assembly. 
+ *              The code borrowed some ideas from ARM RL-RTX source code
+ *
+ *****************************************************************************/
+
+#include "k_rtx.h"
+#include "k_inc.h"
+
+/**************************************************************************//**
+ * @brief   	pop off exception stack frame from the stack
+ * @pre         PSP is used in thread mode before entering any exception
+ *              SVC_Handler is configured as the highest interrupt priority
+ *****************************************************************************/
+__asm void __rte(void)
+{
+    PRESERVE8
+    EXPORT  SVC_RTE
+SVC_RTE
+    MVN     LR, #:NOT:0xFFFFFFFD    // set EXC_RETURN value, Thread mode, PSP
+    BX      LR    
+    ALIGN
+}
+
+/**************************************************************************//**
+ * @brief   	SVC Handler
+ * @pre         PSP is used in thread mode before entering SVC Handler
+ *              SVC_Handler is configured as the highest interrupt priority
+ *****************************************************************************/
+
+void SVC_Handler(void)
+{
+    
+    U8   svc_number;
+    U32  ret  = RTX_OK;                 // default return value of a function
+    U32 *args = (U32 *) __get_PSP();    // read PSP to get stacked args
+    
+    svc_number = ((S8 *) args[6])[-2];  // Memory[(Stacked PC) - 2]
+    switch(svc_number) {
+        case SVC_RTX_INIT:
+            ret = k_rtx_init((RTX_SYS_INFO*) args[0], (TASK_INIT *) args[1], (int) args[2]);
+            break;
+        case SVC_MEM_ALLOC:
+            ret = (U32) k_mpool_alloc(MPID_IRAM1, (size_t) args[0]);
+            break;
+        case SVC_MEM_DEALLOC:
+            ret = k_mpool_dealloc(MPID_IRAM1, (void *)args[0]);
+            break;
+        case SVC_MEM_DUMP:
+            ret = k_mpool_dump(MPID_IRAM1);
+            break;
+        case SVC_TSK_CREATE:
+            ret = k_tsk_create((task_t *)(args[0]), (void (*)(void))(args[1]), (U8)(args[2]), (U32) (args[3]));
+            break;
+        case SVC_TSK_EXIT:
+            k_tsk_exit();
+            break;
+        case SVC_TSK_YIELD:
+            ret = k_tsk_yield();
+            break;
+        case SVC_TSK_SET_PRIO:
+            ret = k_tsk_set_prio((task_t) args[0], (U8) args[1]);
+            break;
+        case SVC_TSK_GET:
+            ret = k_tsk_get((task_t ) args[0], (RTX_TASK_INFO *) args[1]);
+            break;
+        case SVC_TSK_GETTID:
+            ret = k_tsk_gettid();
+            break;
+        case SVC_TSK_LS:
+            ret = k_tsk_ls((task_t *) args[0], (size_t) args[1]);
+            break;
+        case SVC_MBX_CREATE:
+            ret = k_mbx_create((size_t) args[0]);
+            break;
+        case SVC_MBX_SEND:
+            ret = k_send_msg((task_t) args[0], (const void *) args[1]);
+            break;
+        case SVC_MBX_SEND_NB:
+            ret = k_send_msg_nb((task_t) args[0], (const void *) args[1]);
+            break;
+        case SVC_MBX_RECV:
+            ret = k_recv_msg((void *) args[0], (size_t) args[1]);
+            break;
+        case SVC_MBX_RECV_NB:
+            ret = k_recv_msg_nb((void *) args[0], (size_t) args[1]);
+            break;
+        case SVC_MBX_LS:
+            ret = k_mbx_ls((task_t *) args[0], (size_t) args[1]);
+            break;
+        case SVC_MBX_GET:
+            ret = k_mbx_get((task_t) args[0]);
+            break;
+        case SVC_RT_TSK_SET:
+            ret = k_rt_tsk_set((TIMEVAL*) args[0]);
+            break;
+        case SVC_RT_TSK_SUSP:
+            ret = k_rt_tsk_susp();
+            break;
+        case SVC_RT_TSK_GET:
+            ret = k_rt_tsk_get((task_t) args[0], (TIMEVAL *) args[1]);
+            break;
+        case SVC_POOL_CREATE:
+            ret = k_tsk_pool_create((U8) args[0], (U8) args[1], (U32) args[2]);
+            break;
+        case SVC_POOL_SUBMIT:
+            ret = k_tsk_pool_submit((int) args[0], (void (*)(void *)) args[1], (void *) args[2]);
+            break;
+        case SVC_POOL_TAKE:
+            ret = k_tsk_pool_take((int) args[0], (POOL_JOB *) args[1]);
+            break;
+        case SVC_CBS_CREATE:
+            ret = k_cbs_create((TIMEVAL *) args[0], (TIMEVAL *) args[1]);
+            break;
+        case SVC_CBS_ATTACH:
+            ret = k_cbs_attach((task_t) args[0], (int) args[1]);
+            break;
+        case SVC_RT_TSK_BUDGET:
+            ret = k_rt_tsk_set_budget((TIMEVAL *) args[0]);
+            break;
+        case SVC_MSG_ALLOC:
+            ret = (U32) k_msg_alloc((size_t) args[0]);
+            break;
+        case SVC_MSG_FREE:
+            ret = k_msg_free((void *) args[0]);
+            break;
+        case SVC_MBX_SEND_ZC:
+            ret = k_send_msg_zc((task_t) args[0], (void *) args[1]);
+            break;
+        case SVC_MBX_RECV_ZC:
+            ret = k_recv_msg_zc((void **) args[0]);
+            break;
+        case SVC_MBX_CREATE_EX:
+            ret = k_mbx_create_ex((size_t) args[0]);
+            break;
+        case SVC_MBX_DELETE:
+            ret = k_mbx_delete((mbx_t) args[0]);
+            break;
+        case SVC_MBX_SEND_TO:
+            ret = k_send_msg_mbx((mbx_t) args[0], (const void *) args[1], TMO_FOREVER);
+            break;
+        case SVC_MBX_SEND_TO_NB:
+            ret = k_send_msg_mbx((mbx_t) args[0], (const void *) args[1], 0);
+            break;
+        case SVC_MBX_RECV_FROM:
+            ret = k_recv_msg_mbx((mbx_t) args[0], (void *) args[1], (size_t) args[2], TMO_FOREVER);
+            break;
+        case SVC_MBX_RECV_FROM_NB:
+            ret = k_recv_msg_mbx((mbx_t) args[0], (void *) args[1], (size_t) args[2], 0);
+            break;
+        case SVC_MBX_SEND_TMO:
+            ret = k_send_msg_timeout((task_t) args[0], (const void *) args[1], (TIMEVAL *) args[2]);
+            break;
+        case SVC_MBX_RECV_TMO:
+            ret = k_recv_msg_timeout((void *) args[0], (size_t) args[1], (TIMEVAL *) args[2]);
+            break;
+        case SVC_MBX_SELECT:
+            ret = k_mbx_select((mbx_t *) args[0], (int) args[1], (TIMEVAL *) args[2]);
+            break;
+        case SVC_MBX_SET_MODE:
+            ret = k_mbx_set_mode((mbx_t) args[0], (int) args[1]);
+            break;
+        case SVC_MBX_SEND_BATCH:
+            ret = k_send_msg_batch((task_t) args[0], (const void *) args[1], (int) args[2]);
+            break;
+        case SVC_MBX_RECV_BATCH:
+            ret = k_recv_msg_batch((void *) args[0], (size_t) args[1], (int) args[2]);
+            break;
+        case SVC_TOPIC_SUB:
+            ret = k_topic_subscribe((int) args[0], (mbx_t) args[1], (int) args[2]);
+            break;
+        case SVC_TOPIC_UNSUB:
+            ret = k_topic_unsubscribe((int) args[0], (mbx_t) args[1]);
+            break;
+        case SVC_TOPIC_PUB:
+            ret = k_topic_publish((int) args[0], (const void *) args[1]);
+            break;
+        case SVC_MSG_CALL:
+            ret = k_msg_call((task_t) args[0], (const void *) args[1], (void *) args[2], (size_t) args[3]);
+            break;
+        case SVC_MSG_REPLY:
+            ret = k_msg_reply((task_t) args[0], (const void *) args[1]);
+            break;
+        case SVC_UART_GETC:
+            ret = k_uart_getc();
+            break;
+        case SVC_TSK_NOTIFY:
+            ret = k_tsk_notify((task_t) args[0], (U32) args[1], (int) args[2]);
+            break;
+        case SVC_TSK_NOTIFY_WAIT:
+            ret = k_tsk_notify_wait((U32) args[0], (TIMEVAL *) args[1]);
+            break;
+        case SVC_SEM_CREATE:
+            ret = k_sem_create((int) args[0]);
+            break;
+        case SVC_SEM_WAIT:
+            ret = k_sem_wait((int) args[0], (TIMEVAL *) args[1]);
+            break;
+        case SVC_SEM_POST:
+            ret = k_sem_post((int) args[0]);
+            break;
+        case SVC_MUTEX_CREATE:
+            ret = k_mutex_create();
+            break;
+        case SVC_MUTEX_LOCK:
+            ret = k_mutex_lock((int) args[0]);
+            break;
+        case SVC_MUTEX_UNLOCK:
+            ret = k_mutex_unlock((int) args[0]);
+            break;
+        case SVC_FUTEX_WAIT:
+            ret = k_futex_wait((volatile U32 *) args[0], (U32) args[1]);
+            break;
+        case SVC_FUTEX_WAKE:
+            ret = k_futex_wake((volatile U32 *) args[0], (int) args[1]);
+            break;
+        case SVC_EVT_CREATE:
+            ret = k_evt_create();
+            break;
+        case SVC_EVT_SET:
+            ret = k_evt_set((int) args[0], (U32) args[1]);
+            break;
+        case SVC_EVT_CLEAR:
+            ret = k_evt_clear((int) args[0], (U32) args[1]);
+            break;
+        case SVC_EVT_WAIT:
+            ret = k_evt_wait((int) args[0], (U32) args[1], (int) args[2], (TIMEVAL *) args[3]);
+            break;
+        case SVC_MSGPOOL_CREATE:
+            ret = k_msgpool_create((size_t) args[0], (int) args[1]);
+            break;
+        case SVC_MSGPOOL_GET:
+            ret = (U32) k_msgpool_get((int) args[0], (TIMEVAL *) args[1]);
+            break;
+        case SVC_MSGPOOL_PUT:
+            ret = k_msgpool_put((int) args[0], (void *) args[1]);
+            break;
+        case SVC_MBX_PEEK:
+            ret = k_mbx_peek_msg((mbx_t) args[0], (RTX_MSG_HDR *) args[1]);
+            break;
+        case SVC_MBX_RECV_TYPE:
+            ret = k_recv_msg_type((U32) args[0], (void *) args[1], (size_t) args[2], (TIMEVAL *) args[3]);
+            break;
+        case SVC_MBX_STAT:
+            ret = k_mbx_stat((mbx_t) args[0], (MBX_STAT *) args[1]);
+            break;
+        case SVC_CHAN_CREATE:
+            ret = k_chan_create((size_t) args[0], (task_t) args[1], (task_t) args[2]);
+            break;
+        case SVC_CHAN_OPEN:
+            ret = (U32) k_chan_open((int) args[0]);
+            break;
+        case SVC_CHAN_WAIT:
+            ret = k_chan_wait((int) args[0], (TIMEVAL *) args[1]);
+            break;
+        case SVC_CHAN_WAKE:
+            ret = k_chan_wake((int) args[0]);
+            break;
+        case SVC_CHAN_DELETE:
+            ret = k_chan_delete((int) args[0]);
+            break;
+        case SVC_MSGPOOL_DELETE:
+            ret = k_msgpool_delete((int) args[0]);
+            break;
+        case SVC_UART_SELECT:
+            ret = k_uart_select((mbx_t) args[0]);
+            break;
+#ifdef ECE350_P1
+        // The following are only for P1 memory testing purpose
+        // Future deliverables do not provide the following sys calls to tasks
+        case SVC_MEM2_ALLOC:
+            ret = (U32) k_mpool_alloc(MPID_IRAM2, (size_t) args[0]);
+            break;
+        case SVC_MEM2_DEALLOC:
+            ret = k_mpool_dealloc(MPID_IRAM2, (void *)args[0]);
+            break;
+        case SVC_MEM2_DUMP:
+            ret = k_mpool_dump(MPID_IRAM2);
+            break;
+#endif
+        default:
+            ret = (U32) RTX_ERR;
+    }
+    
+    args[0] = ret;      // return value saved onto the stacked R0
+}
+
+
+/*
+ *===========================================================================
+ *                             END OF FILE
+ *===========================================================================
+ */
+
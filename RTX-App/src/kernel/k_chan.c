@@ -0,0 +1,296 @@
+/*
+ ****************************************************************************
+ *
+ *                  UNIVERSITY OF WATERLOO ECE 350 RTX LAB  
+ *
+ *                     Copyright 2020-2022 Yiqing Huang
+ *                          All rights reserved.
+ *---------------------------------------------------------------------------
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice and the following disclaimer.
+ *
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS AND CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *---------------------------------------------------------------------------*/
+ 
+
+/**************************************************************************//**
+ * @file        k_chan.c
+ * @brief       kernel shared-memory producer/consumer channels
+ *
+ * @details     A channel is a ring taken from IRAM2 by chan_create and
+ *              handed by chan_open to its two tasks only. The producer
+ *              copies data in and advances head, the consumer copies it
+ *              out and advances tail, neither enters the kernel for that.
+ *              The kernel is only involved when one side finds the ring
+ *              empty or full: chan_wait parks it and flags the ring, the
+ *              other side sees the flag after its next update and calls
+ *              chan_wake. See libu/chan.c. A channel goes away with
+ *              chan_delete or when either end exits; a task parked on it
+ *              then gets ENOENT.
+ *****************************************************************************/
+
+#include "k_inc.h"
+#include "k_rtx.h"
+#include "k_task.h"
+#include "k_mem.h"
+#include "k_sync.h"
+#include "k_chan.h"
+
+CHAN g_chans[MAX_CHANS];
+
+void k_chan_init(void)
+{
+    for (int i = 0; i < MAX_CHANS; i++) {
+        g_chans[i].used = 0;
+        g_chans[i].gen  = 0;
+        q_init_list_head(&g_chans[i].wait);
+    }
+}
+
+/**************************************************************************//**
+ * @brief   look up a channel the calling task is an end of
+ * @return  the channel, NULL with errno EINVAL or EPERM
+ *****************************************************************************/
+static CHAN *k_chan_lookup(int chan)
+{
+    CHAN *p_chan;
+
+    if (chan < 0 || chan >= MAX_CHANS || !g_chans[chan].used) {
+        errno = EINVAL;
+        return NULL;
+    }
+    p_chan = &g_chans[chan];
+    if (gp_current_task->tid != p_chan->producer && gp_current_task->tid != p_chan->consumer) {
+        errno = EPERM;
+        return NULL;
+    }
+    return p_chan;
+}
+
+/**************************************************************************//**
+ * @brief   free a channel slot and fail whoever is parked on it
+ * @note    the waiter tells by the changed gen, the slot may be taken
+ *          again before it gets to run
+ *****************************************************************************/
+static void k_chan_free(CHAN *p_chan)
+{
+    TCB *p_tcb;
+
+    p_chan->used = 0;
+    p_chan->gen++;
+    k_mpool_dealloc(MPID_IRAM2, p_chan->ring);
+    p_chan->ring = NULL;
+    while ((p_tcb = q_list_first_entry_or_null(&p_chan->wait)) != NULL) {
+        k_sync_wake(p_tcb);
+    }
+}
+
+/**************************************************************************//**
+ * @brief       create a channel from producer to consumer
+ * @return      channel ID on success; RTX_ERR on failure
+ * @param       size    data bytes in the ring, a power of two of at least 4
+ * @details     Any task may set a channel up for two other tasks, only
+ *              the two ends can open and use it.
+ *****************************************************************************/
+int k_chan_create(size_t size, task_t producer, task_t consumer)
+{
+#ifdef DEBUG_0
+    printf("k_chan_create: size = %u, producer = %d, consumer = %d\r\n", size, producer, consumer);
+#endif /* DEBUG_0 */
+    CHAN *p_chan = NULL;
+    CHAN_RING *p_ring;
+    int chan;
+
+    if (size < 4 || (size & (size - 1)) != 0 || producer == consumer ||
+        producer >= MAX_TASKS || consumer >= MAX_TASKS ||
+        g_tcbs[producer].state == DORMANT || g_tcbs[consumer].state == DORMANT) {
+        errno = EINVAL;
+        return RTX_ERR;
+    }
+    for (chan = 0; chan < MAX_CHANS; chan++) {
+        if (!g_chans[chan].used) {
+            p_chan = &g_chans[chan];
+            break;
+        }
+    }
+    if (p_chan == NULL) {
+        errno = ENOMEM;
+        return RTX_ERR;
+    }
+    p_ring = k_mpool_alloc(MPID_IRAM2, sizeof(CHAN_RING) + size);
+    if (p_ring == NULL) {
+        errno = ENOMEM;
+        return RTX_ERR;
+    }
+    p_ring->head    = 0;
+    p_ring->tail    = 0;
+    p_ring->waiting = CHAN_WAIT_NONE;
+    p_ring->chan    = chan;
+    p_ring->size    = size;
+    p_chan->ring     = p_ring;
+    p_chan->producer = producer;
+    p_chan->consumer = consumer;
+    p_chan->used     = 1;
+    return chan;
+}
+
+/**************************************************************************//**
+ * @brief       map a channel into the calling task
+ * @return      the shared ring on success; NULL on failure
+ * @note        only the producer and the consumer get the ring
+ *****************************************************************************/
+CHAN_RING *k_chan_open(int chan)
+{
+#ifdef DEBUG_0
+    printf("k_chan_open: chan = %d\r\n", chan);
+#endif /* DEBUG_0 */
+    CHAN *p_chan = k_chan_lookup(chan);
+
+    return p_chan == NULL ? NULL : p_chan->ring;
+}
+
+/**************************************************************************//**
+ * @brief       wait until the ring has room (producer) or data (consumer)
+ * @return      RTX_OK once it has; RTX_ERR on failure with errno EAGAIN
+ *              for a {0, 0} timeout, ETIMEDOUT otherwise
+ * @param       p_tv    how long to wait, NULL waits forever
+ * @details     The condition is checked here with the other side held
+ *              off, so an update made just before the call is never
+ *              missed. The ring's waiting flag tells the other side to
+ *              call chan_wake after its next update.
+ *****************************************************************************/
+int k_chan_wait(int chan, TIMEVAL *p_tv)
+{
+#ifdef DEBUG_0
+    printf("k_chan_wait: chan = %d, p_tv = 0x%x\r\n", chan, p_tv);
+#endif /* DEBUG_0 */
+    U32 timeout = k_tv_to_ticks(p_tv);
+    CHAN *p_chan = k_chan_lookup(chan);
+    CHAN_RING *p_ring;
+    U8 want;
+    U8 gen;
+
+    if (p_chan == NULL) {
+        return RTX_ERR;
+    }
+    p_ring = p_chan->ring;
+    if (gp_current_task->tid == p_chan->producer) {
+        if (p_ring->head - p_ring->tail < p_ring->size) {
+            return RTX_OK;
+        }
+        want = CHAN_WAIT_ROOM;
+    } else {
+        if (p_ring->head != p_ring->tail) {
+            return RTX_OK;
+        }
+        want = CHAN_WAIT_DATA;
+    }
+    if (timeout == 0) {
+        errno = EAGAIN;
+        return RTX_ERR;
+    }
+    gp_current_task->timed_out = 0;
+    if (timeout != TMO_FOREVER) {
+        k_tmo_arm(gp_current_task, timeout);
+    }
+    p_ring->waiting = want;
+    gen = p_chan->gen;
+    gp_current_task->blk_on = chan;
+    gp_current_task->state = BLK_CHAN;
+    k_sync_enqueue(&p_chan->wait, gp_current_task);
+    k_tsk_run_new();
+    if (p_chan->gen != gen) {
+        errno = ENOENT;     // the channel got deleted while we were parked
+        return RTX_ERR;
+    }
+    if (gp_current_task->timed_out) {
+        p_ring->waiting = CHAN_WAIT_NONE;
+        errno = ETIMEDOUT;
+        return RTX_ERR;
+    }
+    return RTX_OK;
+}
+
+/**************************************************************************//**
+ * @brief       wake the other end of a channel parked in chan_wait
+ * @return      RTX_OK on success; RTX_ERR on failure
+ * @note        called by libu/chan.c only when the ring's waiting flag is
+ *              set, so the kernel is entered at empty and full transitions
+ *****************************************************************************/
+int k_chan_wake(int chan)
+{
+#ifdef DEBUG_0
+    printf("k_chan_wake: chan = %d\r\n", chan);
+#endif /* DEBUG_0 */
+    CHAN *p_chan = k_chan_lookup(chan);
+    TCB *p_tcb;
+
+    if (p_chan == NULL) {
+        return RTX_ERR;
+    }
+    p_tcb = q_list_first_entry_or_null(&p_chan->wait);
+    if (p_tcb == NULL) {
+        return RTX_OK;
+    }
+    p_chan->ring->waiting = CHAN_WAIT_NONE;
+    k_sync_wake(p_tcb);
+    k_sync_preempt(p_tcb);
+    return RTX_OK;
+}
+
+/**************************************************************************//**
+ * @brief       delete a channel, either end may do so
+ * @return      RTX_OK on success; RTX_ERR on failure
+ * @note        the ring goes back to IRAM2, neither end may touch it
+ *              afterwards. A task parked in chan_wait fails with ENOENT.
+ *****************************************************************************/
+int k_chan_delete(int chan)
+{
+#ifdef DEBUG_0
+    printf("k_chan_delete: chan = %d\r\n", chan);
+#endif /* DEBUG_0 */
+    CHAN *p_chan = k_chan_lookup(chan);
+    TCB *p_tcb;
+
+    if (p_chan == NULL) {
+        return RTX_ERR;
+    }
+    p_tcb = q_list_first_entry_or_null(&p_chan->wait);
+    k_chan_free(p_chan);
+    if (p_tcb != NULL) {
+        k_sync_preempt(p_tcb);
+    }
+    return RTX_OK;
+}
+
+/**************************************************************************//**
+ * @brief   delete every channel the task is an end of, used on exit so a
+ *          later task with the same TID gets no access to them
+ *****************************************************************************/
+void k_chan_release_task(task_t tid)
+{
+    for (int i = 0; i < MAX_CHANS; i++) {
+        if (g_chans[i].used && (g_chans[i].producer == tid || g_chans[i].consumer == tid)) {
+            k_chan_free(&g_chans[i]);
+        }
+    }
+}
+
+/*
+ *===========================================================================
+ *                             END OF FILE
+ *===========================================================================
+ */
@@ -0,0 +1,82 @@
+/*
+ ****************************************************************************
+ *
+ *                  UNIVERSITY OF WATERLOO ECE 350 RTX LAB  
+ *
+ *                     Copyright 2020-2022 Yiqing Huang
+ *                          All rights reserved.
+ *---------------------------------------------------------------------------
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice and the following disclaimer.
+ *
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS AND CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *---------------------------------------------------------------------------*/
+ 
+
+/**************************************************************************//**
+ * @file        k_chan.h
+ * @brief       kernel shared-memory producer/consumer channels header file
+ *****************************************************************************/
+
+#ifndef K_CHAN_H_
+#define K_CHAN_H_
+
+#include "k_inc.h"
+
+/*
+ *===========================================================================
+ *                             STRUCTURES
+ *===========================================================================
+ */
+
+typedef struct k_chan {
+    CHAN_RING  *ring;           /**< shared control block and data      */
+    task_t      producer;       /**< only task allowed to produce       */
+    task_t      consumer;       /**< only task allowed to consume       */
+    U8          used;           /**< slot taken by chan_create          */
+    U8          gen;            /**< bumped each time the slot is freed */
+    TCB         wait;           /**< BLK_CHAN waiter, list head         */
+} CHAN;
+
+/*
+ *===========================================================================
+ *                            GLOBAL VARIABLES
+ *===========================================================================
+ */
+
+extern CHAN g_chans[MAX_CHANS];
+
+/*
+ *===========================================================================
+ *                            FUNCTION PROTOTYPES
+ *===========================================================================
+ */
+
+void k_chan_init        (void);
+int  k_chan_create      (size_t size, task_t producer, task_t consumer);
+CHAN_RING *k_chan_open  (int chan);
+int  k_chan_wait        (int chan, TIMEVAL *p_tv);
+int  k_chan_wake        (int chan);
+int  k_chan_delete      (int chan);
+void k_chan_release_task(task_t tid);
+
+#endif // ! K_CHAN_H_
+
+/*
+ *===========================================================================
+ *                             END OF FILE
+ *===========================================================================
+ */
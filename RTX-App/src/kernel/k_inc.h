@@ -1,140 +1,215 @@
-/*
- ****************************************************************************
- *
- *                  UNIVERSITY OF WATERLOO ECE 350 RTOS LAB
- *
- *                     Copyright 2020-2022 Yiqing Huang
- *                          All rights reserved.
- *
- *  Redistribution and use in source and binary forms, with or without
- *  modification, are permitted provided that the following conditions are met:
- *  - Redistributions of source code must retain the above copyright
- *    notice and the following disclaimer.
- *
- *
- *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
- *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
- *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
- *  ARE DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS AND CONTRIBUTORS BE
- *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
- *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
- *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
- *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
- *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
- *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
- *  POSSIBILITY OF SUCH DAMAGE.
- ****************************************************************************
- */
-
-/**************************************************************************//**
- * @file        k_inc.h
- * @brief       Kernel Macros and Data Structure Header file
- *              l2
- * @version     V1.2021.01
- * @authors     Yiqing Huang
- * @date        2021 JAN
- *
- * @note        all kernel .c files include this one
- *
- *****************************************************************************/
-
-#ifndef K_INC_H_
-#define K_INC_H_
-
-#include "LPC17xx.h"
-#include "lpc1768_mem.h"
-#include "common.h"
-#include "rtx_errno.h"
-#include "uart_polling.h"
-#include "printf.h"
-
-/*
- *===========================================================================
- *                             MACROS
- *===========================================================================
- */
-
-#define NUM_TASKS 3     // only supports three tasks in the starter code 
-                        // due to limited user stack space
-/*
- *===========================================================================
- *                             STRUCTURES
- *===========================================================================
- */
-/**
- * @brief TCB data structure definition to support two kernel tasks.
- * @note  You will need to modify this data structure!!!
- */
-// The following offset macros needs to be modified if you modify
-// the positions of msp field in the TCB structure
-#define TCB_MSP_OFFSET  8       // TCB.msp offset 
-
-typedef struct tcb {
-    struct tcb *prev;         /**< prev tcb, not used in the starter code     */
-    struct tcb *next;         /**< next tcb, not used in the starter code     */
-    U32        *msp;          /**< kernel sp of the task, TCB_MSP_OFFSET = 8  */
-    U8          priv;         /**< = 0 unprivileged, =1 privileged,           */    
-    U8          tid;          /**< task id                                    */
-    U8          prio;         /**< scheduling priority                        */
-    U8          state;        /**< task state                                 */
-    U32         u_stack_size;       /**< user stack size in bytes           */
-    U32         u_sp;               /**< top of user stack                  */
-    U32         u_sp_base;          /**< user stack base addr. (high addr.) */		
-	  void        (*ptask)();         /**< task entry address                 */
-		int					length_of_task_buf;
-		uint32_t    period;
-		uint32_t    release_time;
-		int         rt_flag;
-} TCB;
-typedef struct ringbuf{
-		void *buffer;
-		U32   roffset;
-		U32   woffset;
-		U32   size;
-		int  writesize;
-		int  readsize;
-		TCB   queue[4];
-}RB;
-void cpymem(void *dest, const void *src, size_t count);
-void init_rb (RB* rb, U32 size);
-void write_rb(RB* ringbuffer,U32 size, const void* buf);
-void read_rb(RB* rb,U32 size, void* buf);
-void setmem(void *dst, int val, size_t count);
-void free_rb(RB* rb);
-/*
- *===========================================================================
- *                             GLOBAL VARIABLES 
- *===========================================================================
- */
-extern int  errno;      // defined in k_rtx_init.c file
-extern RB   uart_mb;
-extern U8 	r_count;
-// Memory related globals are defined in k_mem.c
-// kernel stack size
-extern const U32 g_k_stack_size;    // kernel stack size
-extern const U32 g_p_stack_size;    // process stack size
-
-// task kernel stacks are statically allocated inside the OS image
-extern U32 g_k_stacks[MAX_TASKS][KERN_STACK_SIZE >> 2] __attribute__((aligned(8)));
-
-// process stack for tasks, statically allocated inside the OS image  */
-//extern U32 g_p_stacks[MAX_TASKS][PROC_STACK_SIZE >> 2] __attribute__((aligned(8)));
-extern U32 g_p_stacks[NUM_TASKS][PROC_STACK_SIZE >> 2] __attribute__((aligned(8)));
-
-// task related globals are defined in k_task.c
-extern TCB *gp_current_task;    // always point to the current RUNNING task
-
-// TCBs are statically allocated inside the OS image
-extern TCB g_tcbs[MAX_TASKS];
-extern TASK_INIT g_null_task_info;
-extern U32 g_num_active_tasks;	// number of non-dormant tasks */
-
-extern volatile uint32_t g_timer_count;     // remove if you do not need this variable
-
-#endif  // !K_INC_H_
-
-/*
- *===========================================================================
- *                             END OF FILE
- *===========================================================================
- */
+/*
+ ****************************************************************************
+ *
+ *                  UNIVERSITY OF WATERLOO ECE 350 RTOS LAB
+ *
+ *                     Copyright 2020-2022 Yiqing Huang
+ *                          All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice and the following disclaimer.
+ *
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS AND CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ ****************************************************************************
+ */
+
+/**************************************************************************//**
+ * @file        k_inc.h
+ * @brief       Kernel Macros and Data Structure Header file
+ *              l2
+ * @version     V1.2021.01
+ * @authors     Yiqing Huang
+ * @date        2021 JAN
+ *
+ * @note        all kernel .c files include this one
+ *
+ *****************************************************************************/
+
+#ifndef K_INC_H_
+#define K_INC_H_
+
+#include "LPC17xx.h"
+#include "lpc1768_mem.h"
+#include "common.h"
+#include "rtx_errno.h"
+#include "uart_polling.h"
+#include "printf.h"
+
+/*
+ *===========================================================================
+ *                             MACROS
+ *===========================================================================
+ */
+
+#define NUM_TASKS 3     // only supports three tasks in the starter code 
+                        // due to limited user stack space
+
+#if MAX_TASKS > TID_TIMER
+#error "MAX_TASKS must leave the reserved TIDs (TID_TIMER and above) unused"
+#endif
+#if MAX_MBX > 127
+#error "MAX_MBX must fit in mbx_t"
+#endif
+
+/* bitmaps indexed by TID or mailbox ID, MSB of word 0 is index 0 so that
+   __clz() returns the lowest index */
+#define BM_WORDS(n)     (((n) + 31) >> 5)       /* words to hold n bits */
+#define BM_BIT(i)       (0x80000000UL >> ((i) & 31))
+/*
+ *===========================================================================
+ *                             STRUCTURES
+ *===========================================================================
+ */
+/**
+ * @brief TCB data structure definition to support two kernel tasks.
+ * @note  You will need to modify this data structure!!!
+ */
+// The following offset macros needs to be modified if you modify
+// the positions of msp field in the TCB structure
+#define TCB_MSP_OFFSET  8       // TCB.msp offset 
+
+typedef struct tcb {
+    struct tcb *prev;         /**< prev tcb, not used in the starter code     */
+    struct tcb *next;         /**< next tcb, not used in the starter code     */
+    U32        *msp;          /**< kernel sp of the task, TCB_MSP_OFFSET = 8  */
+    U8          priv;         /**< = 0 unprivileged, =1 privileged,           */    
+    U8          tid;          /**< task id                                    */
+    U8          prio;         /**< scheduling priority                        */
+    U8          state;        /**< task state                                 */
+    U32         u_stack_size;       /**< user stack size in bytes           */
+    U32         u_sp;               /**< top of user stack                  */
+    U32         u_sp_base;          /**< user stack base addr. (high addr.) */		
+	  void        (*ptask)();         /**< task entry address                 */
+		int					length_of_task_buf;
+		uint32_t    period;
+		uint32_t    release_time;
+		int         rt_flag;
+		S8          pool;           /**< worker pool ID, -1 if not a pool worker */
+		S8          cbs;            /**< bandwidth server ID, -1 if not served */
+		U32         wcet;           /**< per-job execution budget in ticks, 0 = unlimited */
+		U32         exec;           /**< ticks consumed by the current job */
+		U32         overruns;       /**< number of jobs throttled on their budget */
+		struct tcb *t_prev;         /**< timer queue links, sorted by t_expire */
+		struct tcb *t_next;
+		U32         t_expire;       /**< tick at which a blocking call times out */
+		U8          t_armed;        /**< linked into the timer queue */
+		U8          timed_out;      /**< the last blocking wait ended by timeout */
+		S8          mbx_admit;      /**< mailbox holding room for our pending send, -1 if none */
+		U32         blk_since;      /**< tick the task last blocked on a mailbox */
+		void       *rpc_buf;        /**< reply buffer while blocked in msg_call */
+		U32         rpc_len;        /**< size of rpc_buf */
+		U8          rpc_server;     /**< task expected to reply */
+		U8          rpc_err;        /**< errno for the caller, 0 if the reply arrived */
+		U32         notify;         /**< notification word, see tsk_notify */
+		U32         notify_mask;    /**< bits awaited in BLK_NOTIFY */
+		U8          base_prio;      /**< own priority, prio may be inherited above it */
+		U8          blk_on;         /**< object ID in BLK_SEM, BLK_MUTEX, BLK_EVENT, BLK_MSGPOOL, BLK_CHAN */
+		volatile U32 *futex;        /**< futex word waited on in BLK_FUTEX */
+		U32         evt_want;       /**< flags waited for in BLK_EVENT */
+		U32         evt_mask;       /**< same, replaced by the group flags on wakeup */
+		U8          evt_opts;       /**< EVT_WAIT_ALL, EVT_CLEAR */
+		void       *mp_blk;         /**< block handed over by msgpool_put */
+} TCB;
+/* time tasks spent blocked on a mailbox, in ticks */
+typedef struct mbx_wait{
+		U32   count;            /**< number of times a task blocked */
+		U32   ticks;            /**< total ticks blocked */
+		U32   max;              /**< longest single wait */
+}MBX_WAIT;
+/* a message of a priority mailbox, the message bytes follow the node */
+typedef struct msg_node{
+		struct msg_node *next;
+		U32   rsvd;             /**< keeps the message 8-byte aligned */
+}MSG_NODE;
+
+#define MSG_NODE_DATA(p_node)   ((U8 *)((MSG_NODE *)(p_node) + 1))
+
+typedef struct ringbuf{
+		void *buffer;
+		U32   roffset;
+		U32   woffset;
+		U32   size;
+		int  writesize;
+		int  readsize;
+		TCB   queue[4];
+		task_t owner;           /**< the only task allowed to receive */
+		TCB   *receiver;        /**< owner while it is blocked receiving here */
+		U8    mode;             /**< MBX_FIFO or MBX_PRIO */
+		MSG_NODE *pq_head[4];   /**< MBX_PRIO messages, one FIFO per sender priority */
+		MSG_NODE *pq_tail[4];
+		U32   reserved;         /**< bytes promised to admitted senders */
+		MBX_WAIT send_wait;     /**< senders blocked on a full mailbox */
+		MBX_WAIT recv_wait;     /**< owner blocked on an empty mailbox */
+		U32   peak;             /**< most bytes ever queued at once */
+		U32   msgs_in;          /**< messages queued */
+		U32   bytes_in;
+		U32   msgs_out;         /**< messages taken off, received or discarded */
+		U32   bytes_out;
+		U32   nb_drops;         /**< sends failed with ENOSPC instead of blocking */
+}RB;
+#define CPY_WORD_MIN    8       /* shorter copies are not worth aligning */
+#define MBX_BENCH_ITER  256     /* messages per k_mbx_bench measurement */
+
+void cpy_blk32(void *dest, const void *src, size_t count);
+void cpymem(void *dest, const void *src, size_t count);
+void init_rb (RB* rb, U32 size);
+void write_rb(RB* ringbuffer,U32 size, const void* buf);
+void read_rb(RB* rb,U32 size, void* buf);
+void setmem(void *dst, int val, size_t count);
+void free_rb(RB* rb);
+void bm_set      (U32 *map, int idx);
+void bm_clr      (U32 *map, int idx);
+int  bm_test     (const U32 *map, int idx);
+int  bm_first_zero(const U32 *map, int nbits);
+int  bm_list     (const U32 *map, int nbits, task_t *buf, size_t count);
+/*
+ *===========================================================================
+ *                             GLOBAL VARIABLES 
+ *===========================================================================
+ */
+extern int  errno;      // defined in k_rtx_init.c file
+extern RB   uart_mb;
+extern U8 	r_count;
+// Memory related globals are defined in k_mem.c
+// kernel stack size
+extern const U32 g_k_stack_size;    // kernel stack size
+extern const U32 g_p_stack_size;    // process stack size
+
+// task kernel stacks are statically allocated inside the OS image
+extern U32 g_k_stacks[MAX_TASKS][KERN_STACK_SIZE >> 2] __attribute__((aligned(8)));
+
+// process stack for tasks, statically allocated inside the OS image  */
+//extern U32 g_p_stacks[MAX_TASKS][PROC_STACK_SIZE >> 2] __attribute__((aligned(8)));
+extern U32 g_p_stacks[NUM_TASKS][PROC_STACK_SIZE >> 2] __attribute__((aligned(8)));
+
+// task related globals are defined in k_task.c
+extern TCB *gp_current_task;    // always point to the current RUNNING task
+
+// TCBs are statically allocated inside the OS image
+extern TCB g_tcbs[MAX_TASKS];
+extern TASK_INIT g_null_task_info;
+extern U32 g_num_active_tasks;	// number of non-dormant tasks */
+extern U32 g_tid_map[BM_WORDS(MAX_TASKS)];  // bit set = TID in use
+
+extern volatile uint32_t g_timer_count;     // remove if you do not need this variable
+
+#endif  // !K_INC_H_
+
+/*
+ *===========================================================================
+ *                             END OF FILE
+ *===========================================================================
+ */
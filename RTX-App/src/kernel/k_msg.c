@@ -1,420 +1,1836 @@
-/*
- ****************************************************************************
- *
- *                  UNIVERSITY OF WATERLOO ECE 350 RTX LAB  
- *
- *                     Copyright 2020-2022 Yiqing Huang
- *                          All rights reserved.
- *---------------------------------------------------------------------------
- *  Redistribution and use in source and binary forms, with or without
- *  modification, are permitted provided that the following conditions are met:
- *  - Redistributions of source code must retain the above copyright
- *    notice and the following disclaimer.
- *
- *
- *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
- *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
- *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
- *  ARE DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS AND CONTRIBUTORS BE
- *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
- *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
- *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
- *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
- *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
- *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
- *  POSSIBILITY OF SUCH DAMAGE.
- *---------------------------------------------------------------------------*/
- 
-
-/**************************************************************************//**
- * @file        k_msg.c
- * @brief       kernel message passing routines          
- * @version     V1.2021.06
- * @authors     Yiqing Huang
- * @date        2021 JUN
- *****************************************************************************/
-
-#include "k_inc.h"
-#include "k_rtx.h"
-#include "k_task.h"
-#include "k_msg.h"
-RB mailboxes[MAX_TASKS];
-
-void init_rb (RB* rb, U32 size){
-
-		rb->size = size;
-		rb->roffset = 0;
-		rb->writesize = 0;
-		rb->readsize = 0;
-		rb->woffset = 0;
-}
-
-void write_rb(RB* rb,U32 size, const void* buf){
-		if(size+rb->woffset>rb->size){
-			int first_size = rb->size - rb->woffset;
-			int second_size = size - first_size;
-			cpymem(((char *)rb->buffer+rb->woffset),buf,first_size);
-			cpymem((char *)rb->buffer,(char *)buf+first_size,second_size);
-			rb->woffset = second_size;
-
-		}
-		else{
-			cpymem(((char *)rb->buffer+rb->woffset),buf,size);
-			rb->woffset+= size;
-		}
-			rb->writesize += size;
-}
-void read_rb(RB* rb,U32 size, void* buf){
-			if(size+rb->roffset>rb->size){
-			int first_size = rb->size - rb->roffset;
-			int second_size = size - first_size;
-			cpymem(buf,((char *)rb->buffer+rb->roffset),first_size);
-			cpymem((char *)buf+first_size,(char *)rb->buffer,second_size);
-			rb->roffset = second_size;
-		}else{
-			cpymem(buf,((char *)rb->buffer+rb->roffset),size);
-			rb->roffset+= size;
-		}
-			rb->readsize += size;
-}
-int check_rb_empty(RB* rb){
-	return rb->writesize == rb->readsize;
-}
-int check_rb_full(RB* rb){
-	return rb->writesize-rb->readsize == rb->size;
-}
-int get_rb_free_size(RB* rb){
-	return rb->size-(rb->writesize-rb->readsize);
-}
-void cpymem(void *dest, const void *src, size_t count)
-{
- char *tmp = dest;
- const char *s = src;
- while (count--)
-  *tmp++ = *s++ ;
-}
-void setmem(void *dst, int val, size_t count){
-	char* ret = (char*)dst;
-	while (count--)
-	{
-		*ret++ = (char)val;
-	}
-}
-int check_queue_empty(task_t tid){
-		for(int i = HIGH;i <= LOWEST;i++){
-				if(q_list_first_entry_or_null(&(mailboxes[tid].queue[i-HIGH]))){
-					return 0;		
-				}
-			}
-				return 1;
-		}
-TCB* get_waiting_highest(task_t tid, int type){
-		for(int i = HIGH;i <= LOWEST;i++){
-				if(q_list_first_entry_or_null(&(mailboxes[tid].queue[i-HIGH]))){
-					return q_list_first_entry_or_null(&(mailboxes[tid].queue[i-HIGH]));	
-				}
-			}
-				return NULL;
-}
-int get_msg_size(RB* rb){
- int size = 0;
-  int count = 0;
-  if(rb->roffset+4>rb->size){
-   int first_size = rb->size - rb->roffset;
-   int second_size = 4 - first_size;
-   int tmp = rb->roffset;
-   for(int i = 0;i<first_size;i++){
-    size+= ((char *)rb->buffer+tmp)[i]<<(count*8);    
-    count++;
-   }
-   for(int i =0;i<second_size;i++){
-    size+= ((char *)rb->buffer)[i]<<(count*8);
-    count++;
-   }
-  }else{
-   for(int i =0;i<4;i++){
-    size+= ((char *)rb->buffer+rb->roffset)[i]<<(count*8);   
-    count++;
-   };
-  }
-  return size;
-}
-int get_waiting_size(task_t id){
-		return g_tcbs[id].length_of_task_buf;
-}
-
-void free_rb(RB* rb){
-		for(int i =0; i<4;i++){
-			q_init_list_head(&(rb->queue[i]));
-		}
-		rb->buffer = NULL;
-		rb->readsize = 0;
-		rb->roffset = 0;
-		rb->size = 0;
-		rb->woffset = 0;
-		rb->writesize = 0;
-}
-int k_mbx_create(size_t size) {
-#ifdef DEBUG_0
-    printf("k_mbx_create: size = %u\r\n", size);
-#endif /* DEBUG_0 */
-		if(mailboxes[gp_current_task->tid].size != 0){
-			errno = EEXIST;
-			return RTX_ERR;
-		}
-		if(size < MIN_MSG_SIZE){
-			errno = EINVAL;
-			return RTX_ERR;
-		}
-		mailboxes[gp_current_task->tid].buffer = k_mpool_alloc(MPID_IRAM2, size);
-		if(mailboxes[gp_current_task->tid].buffer==NULL){
-			errno = ENOMEM;
-			return RTX_ERR;
-		}
-		init_rb(&mailboxes[gp_current_task->tid],size);
-	for(int i = 0 ;i<4;i++){
-		q_init_list_head(&mailboxes[gp_current_task->tid].queue[i]);
-	}
-    return gp_current_task->tid;
-}
-
-int k_send_msg(task_t receiver_tid, const void *buf) {
-#ifdef DEBUG_0
-    printf("k_send_msg: receiver_tid = %d, buf=0x%x\r\n", receiver_tid, buf);
-#endif /* DEBUG_0 */
-		if(g_tcbs[receiver_tid].state==DORMANT||receiver_tid<1||receiver_tid>MAX_TASKS-1){
-			errno = EINVAL;
-			return RTX_ERR;
-		}
-		if(buf==NULL){
-			errno = EFAULT;
-			return RTX_ERR;
-		}
-		if(mailboxes[receiver_tid].size == 0){
-			errno = ENOENT;
-			return RTX_ERR;
-		}
-		int length = (((char *)buf)[3]<<24)+(((char*)buf)[2]<<16)+(((char*)buf)[1]<<8)+(((char*)buf)[0]);
-		if(length<MIN_MSG_SIZE){
-			errno = EINVAL;
-			return RTX_ERR;
-		}
-		if(length>mailboxes[receiver_tid].size){
-			errno = EMSGSIZE;
-			return RTX_ERR;
-		}
-		gp_current_task->length_of_task_buf = length;
-		int cprio = gp_current_task->prio;
-	while(1){
-	TCB* waiting_send = get_waiting_highest(receiver_tid,BLK_SEND);
-	if(get_rb_free_size(&mailboxes[receiver_tid])>=length&&waiting_send==NULL){
-			write_rb(&mailboxes[receiver_tid],length,buf);
-			//printf("tid %d send_msg to %d successed\n",gp_current_task->tid,receiver_tid);
-	}else{
-			gp_current_task->state = BLK_SEND;
-			q_add_to_list_last(gp_current_task,&(mailboxes[receiver_tid].queue[cprio-HIGH]),mailboxes[receiver_tid].queue[cprio-HIGH].prev);
-			k_tsk_run_new();
-			//printf("tid %d send_msg to %d unblocked\n",gp_current_task->tid,receiver_tid);
-			continue;
-		}
-		//TCB* waiting_recv = get_waiting_highest(receiver_tid,BLK_RECV);
-	if(g_tcbs[receiver_tid].state == BLK_RECV){
-			g_tcbs[receiver_tid].state = READY;
-			q_add_to_list_last(&g_tcbs[receiver_tid],&queue[g_tcbs[receiver_tid].prio-HIGH],queue[g_tcbs[receiver_tid].prio-HIGH].prev);
-			//printf("tid %d unblocked the reciever %d\n",gp_current_task->tid,receiver_tid);
-	}
-    return RTX_OK;
-}
-}
-
-int k_send_msg_nb(task_t receiver_tid, const void *buf) {
-#ifdef DEBUG_0
-    printf("k_send_msg_nb: receiver_tid = %d, buf=0x%x\r\n", receiver_tid, buf);
-#endif /* DEBUG_0 */
-		if(g_tcbs[receiver_tid].state==DORMANT||receiver_tid<1||receiver_tid>MAX_TASKS-1){
-			errno = EINVAL;
-			return RTX_ERR;
-		}
-		if(buf==NULL){
-			errno = EFAULT;
-			return RTX_ERR;
-		}
-		if(mailboxes[receiver_tid].size == 0){
-			errno = ENOENT;
-			return RTX_ERR;
-		}
-		int length = (((char *)buf)[3]<<24)+(((char*)buf)[2]<<16)+(((char*)buf)[1]<<8)+(((char*)buf)[0]);
-		if(length<MIN_MSG_SIZE){
-			errno = EINVAL;
-			return RTX_ERR;
-		}
-		if(length>mailboxes[receiver_tid].size){
-			errno = EMSGSIZE;
-			return RTX_ERR;
-		}
-		gp_current_task->length_of_task_buf = length;
-		TCB* waiting_send = get_waiting_highest(receiver_tid,BLK_SEND);
-	int free_size = get_rb_free_size(&mailboxes[receiver_tid]);
-	if(free_size>=length&&waiting_send==NULL){
-			write_rb(&mailboxes[receiver_tid],length,buf);
-	}else{
-			errno = ENOSPC;
-			return RTX_ERR;
-		}
-		//TCB* waiting_recv = get_waiting_highest(receiver_tid,BLK_RECV);
-	if(g_tcbs[receiver_tid].state == BLK_RECV){
-			g_tcbs[receiver_tid].state = READY;
-			q_add_to_list_last(&g_tcbs[receiver_tid],&queue[g_tcbs[receiver_tid].prio-HIGH],queue[g_tcbs[receiver_tid].prio-HIGH].prev);
-			//printf("unblocked %d receiver\n",receiver_tid);
-	}
-    return RTX_OK;
-}
-
-int k_recv_msg(void *buf, size_t len) {
-#ifdef DEBUG_0
-    printf("k_recv_msg: buf=0x%x, len=%d\r\n", buf, len);
-#endif /* DEBUG_0 */
-		int ctid = gp_current_task->tid;
-		if(buf==NULL){
-			errno = EFAULT;
-			return RTX_ERR;
-		}
-		if(mailboxes[ctid].size==0){
-			errno = ENOENT;
-			return RTX_ERR;
-		}
-	if(!check_rb_empty(&mailboxes[ctid])){
-			int length = get_msg_size(&mailboxes[ctid]);
-			if(len<length){
-				errno = ENOSPC;
-				return RTX_ERR;
-			}
-			read_rb(&mailboxes[ctid],length,buf);
-					//printf("%d receive %d bytes successed\n",gp_current_task->tid ,length);
-	}else{
-		gp_current_task->state = BLK_RECV;
-			//q_add_to_list_last(gp_current_task,&(mailboxes[ctid]->queue[cprio-HIGH]),mailboxes[ctid]->queue[cprio-HIGH].prev);
-			k_tsk_run_new();
-			//printf("%d receive %d bytes unblocked\n",gp_current_task->tid);
-			int length = get_msg_size(&mailboxes[ctid]);
-			read_rb(&mailboxes[ctid],length,buf);
-			//printf("%d receive %d bytes successed\n",gp_current_task->tid ,length);
-		}
-
-		TCB* waiting_task = get_waiting_highest(ctid,BLK_SEND);
-		if(waiting_task){
-
-			int waiting_size = waiting_task->length_of_task_buf;
-			int waiting_prio = waiting_task->prio - HIGH;
-			if(get_rb_free_size(&mailboxes[ctid])>=waiting_size){
-				q_delete_node(waiting_task);
-				waiting_task->state = READY;
-				q_add_to_list_last(waiting_task,&queue[waiting_prio],queue[waiting_prio].prev);
-				//printf("unblocked %d sender\n",waiting_task->tid);
-			}
-		}
-    return RTX_OK;
-}
-
-int k_recv_msg_nb(void *buf, size_t len) {
-#ifdef DEBUG_0
-    printf("k_recv_msg_nb: buf=0x%x, len=%d\r\n", buf, len);
-#endif /* DEBUG_0 */
-		int ctid = gp_current_task->tid;
-		if(buf==NULL){
-			errno = EFAULT;
-			return RTX_ERR;
-		}
-		if(mailboxes[ctid].size==0){
-			errno = ENOENT;
-			return RTX_ERR;
-		}
-
-	if(!check_rb_empty(&mailboxes[ctid])){
-			int length = get_msg_size(&mailboxes[ctid]);
-			if(len<length){
-				errno = ENOSPC;
-				return RTX_ERR;
-			}
-			read_rb(&mailboxes[ctid],length,buf);
-			//printf("%d receive %d bytes successed\n",gp_current_task->tid ,length);
-	}else{
-		errno = ENOMSG;
-		return RTX_ERR;
-		}
-		TCB* waiting_task = get_waiting_highest(ctid,BLK_SEND);
-		if(waiting_task){
-			int waiting_size = waiting_task->length_of_task_buf;
-			int waiting_prio = waiting_task->prio - HIGH;
-			if(get_rb_free_size(&mailboxes[ctid])>=waiting_size){
-				q_delete_node(waiting_task);
-
-				waiting_task->state = READY;
-
-				q_add_to_list_last(waiting_task,&queue[waiting_prio],queue[waiting_prio].prev);
-
-			}
-		}
-    return RTX_OK;
-}
-int k_recv_uart(U8* buf, size_t len){
-		if(!check_rb_empty(&uart_mb)){
-			int length = get_msg_size(&uart_mb);
-			read_rb(&uart_mb,length,buf);
-			return RTX_OK;
-	}else{
-			return RTX_ERR;
-	}
-}
-int k_send_to_uart(const void* buf){
-		int length = (((char *)buf)[3]<<24)+(((char*)buf)[2]<<16)+(((char*)buf)[1]<<8)+(((char*)buf)[0]);
-		gp_current_task->length_of_task_buf = length;
-	int free_size = get_rb_free_size(&uart_mb);
-	if(free_size>=length){
-			write_rb(&uart_mb,length,buf);
-	}else{
-			errno = ENOSPC;
-			return RTX_ERR;
-		}
-		//TCB* waiting_recv = get_waiting_highest(receiver_tid,BLK_RECV);
-
-    return RTX_OK;
-}
-int k_mbx_ls(task_t *buf, size_t count) {
-#ifdef DEBUG_0
-    printf("k_mbx_ls: buf=0x%x, count=%u\r\n", buf, count);
-#endif /* DEBUG_0 */
-	    int tmp_count = 0;
-	if(buf==NULL||count==0){
-		errno = EFAULT;
-		return -1;
-	}
-	    for(int i = 0; i<MAX_TASKS; i++){
-        if(mailboxes[i].size!=0){
-            buf[tmp_count] = i;
-            tmp_count++;
-            if(tmp_count==count){
-                break;
-            }
-        }
-    }
-    return tmp_count<count?tmp_count:count;
-}
-
-int k_mbx_get(task_t tid)
-{
-#ifdef DEBUG_0
-    printf("k_mbx_get: tid=%u\r\n", tid);
-#endif /* DEBUG_0 */
-		if(mailboxes[tid].size == 0){
-			errno = ENOENT;
-			return RTX_ERR;
-		}
-		return get_rb_free_size(&mailboxes[tid]);
-}
-/*
- *===========================================================================
- *                             END OF FILE
- *===========================================================================
- */
-
+/*
+ ****************************************************************************
+ *
+ *                  UNIVERSITY OF WATERLOO ECE 350 RTX LAB  
+ *
+ *                     Copyright 2020-2022 Yiqing Huang
+ *                          All rights reserved.
+ *---------------------------------------------------------------------------
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice and the following disclaimer.
+ *
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS AND CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *---------------------------------------------------------------------------*/
+ 
+
+/**************************************************************************//**
+ * @file        k_msg.c
+ * @brief       kernel message passing routines          
+ * @version     V1.2021.06
+ * @authors     Yiqing Huang
+ * @date        2021 JUN
+ *****************************************************************************/
+
+#include <stddef.h>     /* offsetof */
+#include "k_inc.h"
+#include "k_rtx.h"
+#include "k_task.h"
+#include "k_msg.h"
+RB mailboxes[MAX_MBX];                  // [0, MAX_TASKS) default mailbox of each task, by tid
+U32 g_mbx_map[BM_WORDS(MAX_TASKS)];    // bit set = the task owns a mailbox
+
+void init_rb (RB* rb, U32 size){
+		for(int i = 0; i < 4; i++){
+			rb->pq_head[i] = NULL;
+			rb->pq_tail[i] = NULL;
+		}
+
+		rb->size = size;
+		rb->roffset = 0;
+		rb->writesize = 0;
+		rb->readsize = 0;
+		rb->woffset = 0;
+}
+
+void write_rb(RB* rb,U32 size, const void* buf){
+		if(size+rb->woffset>rb->size){
+			int first_size = rb->size - rb->woffset;
+			int second_size = size - first_size;
+			cpymem(((char *)rb->buffer+rb->woffset),buf,first_size);
+			cpymem((char *)rb->buffer,(char *)buf+first_size,second_size);
+			rb->woffset = second_size;
+
+		}
+		else{
+			cpymem(((char *)rb->buffer+rb->woffset),buf,size);
+			rb->woffset+= size;
+		}
+			rb->writesize += size;
+}
+void read_rb(RB* rb,U32 size, void* buf){
+			if(size+rb->roffset>rb->size){
+			int first_size = rb->size - rb->roffset;
+			int second_size = size - first_size;
+			cpymem(buf,((char *)rb->buffer+rb->roffset),first_size);
+			cpymem((char *)buf+first_size,(char *)rb->buffer,second_size);
+			rb->roffset = second_size;
+		}else{
+			cpymem(buf,((char *)rb->buffer+rb->roffset),size);
+			rb->roffset+= size;
+		}
+			rb->readsize += size;
+}
+int check_rb_empty(RB* rb){
+	return rb->writesize == rb->readsize;
+}
+int check_rb_full(RB* rb){
+	return rb->writesize-rb->readsize == rb->size;
+}
+int get_rb_free_size(RB* rb){
+	return rb->size-(rb->writesize-rb->readsize);
+}
+/* free bytes not yet promised to an admitted sender */
+int k_mbx_space(RB* rb){
+	return get_rb_free_size(rb)-rb->reserved;
+}
+/* account one finished wait that started at tick since */
+void k_mbx_wait_done(MBX_WAIT *p_wait, U32 since){
+	U32 ticks = g_timer_count - since;
+
+	p_wait->count++;
+	p_wait->ticks += ticks;
+	if(ticks > p_wait->max){
+		p_wait->max = ticks;
+	}
+}
+/* account one message queued, the ring already holds its bytes */
+void k_mbx_count_in(RB* rb, U32 length){
+	U32 used = rb->writesize - rb->readsize;
+
+	rb->msgs_in++;
+	rb->bytes_in += length;
+	if(used > rb->peak){
+		rb->peak = used;
+	}
+}
+/* account one message taken off */
+void k_mbx_count_out(RB* rb, U32 length){
+	rb->msgs_out++;
+	rb->bytes_out += length;
+}
+/**************************************************************************//**
+ * @brief   copy count bytes, 32 bytes per LDM/STM pair
+ * @pre     dest and src word aligned, count a non-zero multiple of 32
+ *****************************************************************************/
+__asm void cpy_blk32(void *dest, const void *src, size_t count)
+{
+    PRESERVE8
+    PUSH    {r4-r10}
+cpy_blk32_loop
+    LDMIA   r1!, {r3-r10}
+    STMIA   r0!, {r3-r10}
+    SUBS    r2, r2, #32
+    BNE     cpy_blk32_loop
+    POP     {r4-r10}
+    BX      lr
+    ALIGN
+}
+
+/**************************************************************************//**
+ * @brief   memcpy for the message path
+ * @note    Short copies stay byte wise. Otherwise the destination is
+ *          aligned first, then whole words are moved: with LDM/STM blocks
+ *          when the source ends up aligned too, with unaligned LDR (allowed
+ *          on the Cortex-M3) when it does not. The tail is byte wise.
+ *****************************************************************************/
+void cpymem(void *dest, const void *src, size_t count)
+{
+    U8 *d = dest;
+    const U8 *s = src;
+    size_t blk;
+
+    if (count >= CPY_WORD_MIN) {
+        while ((U32)d & 3) {
+            *d++ = *s++;
+            count--;
+        }
+        if (((U32)s & 3) == 0) {
+            blk = count & ~31u;
+            if (blk != 0) {
+                cpy_blk32(d, s, blk);
+                d += blk;
+                s += blk;
+                count -= blk;
+            }
+            for (; count >= 4; count -= 4, d += 4, s += 4) {
+                *(U32 *)d = *(const U32 *)s;
+            }
+        } else {
+            for (; count >= 4; count -= 4, d += 4, s += 4) {
+                *(U32 *)d = *(const __packed U32 *)s;
+            }
+        }
+    }
+    while (count--) {
+        *d++ = *s++;
+    }
+}
+
+void setmem(void *dst, int val, size_t count)
+{
+    U8 *d = dst;
+    U32 word = (U8) val * 0x01010101UL;
+
+    if (count >= CPY_WORD_MIN) {
+        while ((U32)d & 3) {
+            *d++ = (U8) val;
+            count--;
+        }
+        for (; count >= 4; count -= 4, d += 4) {
+            *(U32 *)d = word;
+        }
+    }
+    while (count--) {
+        *d++ = (U8) val;
+    }
+}
+int check_queue_empty(RB* rb){
+		for(int i = HIGH;i <= LOWEST;i++){
+				if(q_list_first_entry_or_null(&(rb->queue[i-HIGH]))){
+					return 0;		
+				}
+			}
+				return 1;
+		}
+TCB* get_waiting_highest(RB* rb){
+		for(int i = HIGH;i <= LOWEST;i++){
+				if(q_list_first_entry_or_null(&(rb->queue[i-HIGH]))){
+					return q_list_first_entry_or_null(&(rb->queue[i-HIGH]));	
+				}
+			}
+				return NULL;
+}
+int get_msg_size(RB* rb){
+		U8 *p = rb->buffer;
+		U32 off = rb->roffset;
+
+		if(rb->mode == MBX_PRIO){
+			return ((RTX_MSG_HDR *)MSG_NODE_DATA(k_mbx_front(rb)))->length;
+		}
+#ifdef MSG_HDR_ALIGNED
+		return *(U32 *)(p + off);               // messages start on words
+#else
+		if(off + 4 <= rb->size){
+			return *(__packed U32 *)(p + off);     // length field does not wrap
+		}
+#endif
+		return p[off] | (p[(off + 1) % rb->size] << 8) |
+		       (p[(off + 2) % rb->size] << 16) | (p[(off + 3) % rb->size] << 24);
+}
+int get_waiting_size(task_t id){
+		return g_tcbs[id].length_of_task_buf;
+}
+
+void free_rb(RB* rb){
+		for(int i =0; i<4;i++){
+			q_init_list_head(&(rb->queue[i]));
+		}
+		rb->buffer = NULL;
+		rb->readsize = 0;
+		rb->roffset = 0;
+		rb->size = 0;
+		rb->woffset = 0;
+		rb->writesize = 0;
+		rb->reserved = 0;
+}
+/**************************************************************************//**
+ * @brief   set up mailbox slot mbx for the calling task
+ *****************************************************************************/
+int k_mbx_alloc(mbx_t mbx, size_t size) {
+		RB *p_mbx = &mailboxes[mbx];
+
+#ifdef MSG_HDR_ALIGNED
+		size &= ~3U;        // whole words, so no header wraps mid-word
+#endif
+		if(size < MIN_MSG_SIZE){
+			errno = EINVAL;
+			return RTX_ERR;
+		}
+		p_mbx->buffer = k_mpool_alloc(MPID_IRAM2, size);
+		if(p_mbx->buffer==NULL){
+			errno = ENOMEM;
+			return RTX_ERR;
+		}
+		init_rb(p_mbx,size);
+		p_mbx->mode = MBX_FIFO;
+		p_mbx->owner = gp_current_task->tid;
+		p_mbx->receiver = NULL;
+		p_mbx->reserved = 0;
+		setmem(&p_mbx->send_wait,0,sizeof(MBX_WAIT));
+		setmem(&p_mbx->recv_wait,0,sizeof(MBX_WAIT));
+		p_mbx->peak = 0;
+		p_mbx->msgs_in = p_mbx->bytes_in = 0;
+		p_mbx->msgs_out = p_mbx->bytes_out = 0;
+		p_mbx->nb_drops = 0;
+	for(int i = 0 ;i<4;i++){
+		q_init_list_head(&p_mbx->queue[i]);
+	}
+		return mbx;
+}
+
+int k_mbx_create(size_t size) {
+#ifdef DEBUG_0
+    printf("k_mbx_create: size = %u\r\n", size);
+#endif /* DEBUG_0 */
+		if(mailboxes[gp_current_task->tid].size != 0){
+			errno = EEXIST;
+			return RTX_ERR;
+		}
+		if(k_mbx_alloc(gp_current_task->tid, size) == RTX_ERR){
+			return RTX_ERR;
+		}
+		bm_set(g_mbx_map, gp_current_task->tid);
+    return gp_current_task->tid;
+}
+
+/**************************************************************************//**
+ * @brief       create an additional mailbox owned by the calling task
+ * @return      the mailbox handle on success, RTX_ERR on failure
+ * @param       size    ring capacity in bytes
+ * @details     Extra mailboxes live in [MAX_TASKS, MAX_MBX) so a handle
+ *              never clashes with a task's default mailbox, whose handle
+ *              is the tid. Only the owner receives from a mailbox, anyone
+ *              may send to it.
+ *****************************************************************************/
+int k_mbx_create_ex(size_t size) {
+#ifdef DEBUG_0
+    printf("k_mbx_create_ex: size = %u\r\n", size);
+#endif /* DEBUG_0 */
+		for(int mbx = MAX_TASKS; mbx < MAX_MBX; mbx++){
+			if(mailboxes[mbx].size == 0){
+				return k_mbx_alloc(mbx, size);
+			}
+		}
+		errno = EAGAIN;
+		return RTX_ERR;
+}
+
+/**************************************************************************//**
+ * @brief   mailbox behind a handle
+ * @return  the mailbox, NULL with errno set if mbx is not a live mailbox
+ *****************************************************************************/
+RB *k_mbx_lookup(mbx_t mbx) {
+		if(mbx<0||mbx>=MAX_MBX){
+			errno = EINVAL;
+			return NULL;
+		}
+		if(mailboxes[mbx].size == 0){
+			errno = ENOENT;
+			return NULL;
+		}
+		return &mailboxes[mbx];
+}
+
+/**************************************************************************//**
+ * @brief       delete a mailbox of the calling task
+ * @return      RTX_OK on success, RTX_ERR on failure
+ * @details     Queued messages are discarded and blocked senders are woken
+ *              up, their send fails with ENOENT.
+ *****************************************************************************/
+int k_mbx_delete(mbx_t mbx) {
+#ifdef DEBUG_0
+    printf("k_mbx_delete: mbx = %d\r\n", mbx);
+#endif /* DEBUG_0 */
+		RB *p_mbx = k_mbx_lookup(mbx);
+		TCB *p_tcb;
+
+		if(p_mbx == NULL){
+			return RTX_ERR;
+		}
+		if(p_mbx->owner != gp_current_task->tid){
+			errno = EPERM;
+			return RTX_ERR;
+		}
+		k_mbx_drain(p_mbx);
+		if(p_mbx->buffer != NULL){
+			k_mpool_dealloc(MPID_IRAM2,p_mbx->buffer);
+		}
+		while((p_tcb = get_waiting_highest(p_mbx)) != NULL){
+			q_delete_node(p_tcb);
+			p_tcb->state = READY;
+			q_add_to_list_last(p_tcb,&queue[p_tcb->prio-HIGH],queue[p_tcb->prio-HIGH].prev);
+		}
+		for(int i = 0; i < MAX_TASKS; i++){
+			if(g_tcbs[i].mbx_admit == mbx){
+				g_tcbs[i].mbx_admit = -1;   // admitted but not run yet, it finds the mailbox gone
+			}
+		}
+		free_rb(p_mbx);
+		p_mbx->receiver = NULL;
+		k_topic_drop_mbx(mbx);
+		if(mbx < MAX_TASKS){
+			bm_clr(g_mbx_map, mbx);
+		}
+		return RTX_OK;
+}
+
+/**************************************************************************//**
+ * @brief   delete every mailbox owned by the calling task, used on exit
+ *****************************************************************************/
+void k_mbx_delete_all(void) {
+		if(mailboxes[gp_current_task->tid].size != 0){
+			k_mbx_delete(gp_current_task->tid);
+		}
+		for(int mbx = MAX_TASKS; mbx < MAX_MBX; mbx++){
+			if(mailboxes[mbx].size != 0 && mailboxes[mbx].owner == gp_current_task->tid){
+				k_mbx_delete(mbx);
+			}
+		}
+}
+
+/**************************************************************************//**
+ * @brief   message type of the message at the read end of a non-empty ring
+ *****************************************************************************/
+U8 get_msg_type(RB* rb){
+		if(rb->mode == MBX_PRIO){
+			return ((RTX_MSG_HDR *)MSG_NODE_DATA(k_mbx_front(rb)))->type;
+		}
+		return ((U8 *)rb->buffer)[(rb->roffset + offsetof(RTX_MSG_HDR, type)) % rb->size];
+}
+
+/**************************************************************************//**
+ * @brief   priority level of a sender, 0 is the most urgent
+ * @note    real-time priorities map to level 0, below LOWEST to level 3
+ *****************************************************************************/
+int k_msg_level(U8 prio){
+		if(prio < HIGH){
+			return 0;
+		}
+		return prio > LOWEST ? LOWEST - HIGH : prio - HIGH;
+}
+
+/**************************************************************************//**
+ * @brief   oldest message of the most urgent non-empty level
+ * @pre     rb is a non-empty MBX_PRIO mailbox
+ *****************************************************************************/
+MSG_NODE *k_mbx_front(RB* rb){
+		for(int i = 0; i < 4; i++){
+			if(rb->pq_head[i] != NULL){
+				return rb->pq_head[i];
+			}
+		}
+		return NULL;
+}
+
+/**************************************************************************//**
+ * @brief   append a message to the mailbox, filed at the given level if it
+ *          is a priority mailbox
+ * @return  RTX_OK on success, RTX_ERR with ENOMEM if a priority mailbox
+ *          could not get a node for it
+ * @pre     the caller checked the byte budget with get_rb_free_size
+ *****************************************************************************/
+static int k_mbx_put_at(RB* rb, U32 length, const void *buf, int level){
+		MSG_NODE *p_node;
+
+		if(rb->mode != MBX_PRIO){
+			U32 pad = MSG_RB_LEN(length) - length;
+
+			write_rb(rb,length,buf);
+			rb->woffset = (rb->woffset + pad) % rb->size;
+			rb->writesize += pad;
+			k_mbx_count_in(rb,length);
+			return RTX_OK;
+		}
+		p_node = k_mpool_alloc(MPID_IRAM2, sizeof(MSG_NODE) + length);
+		if(p_node == NULL){
+			errno = ENOMEM;
+			return RTX_ERR;
+		}
+		cpymem(MSG_NODE_DATA(p_node),buf,length);
+		p_node->next = NULL;
+		if(rb->pq_head[level] == NULL){
+			rb->pq_head[level] = p_node;
+		}else{
+			rb->pq_tail[level]->next = p_node;
+		}
+		rb->pq_tail[level] = p_node;
+		rb->writesize += MSG_RB_LEN(length);    // the byte budget is kept the same way as the ring
+		k_mbx_count_in(rb,length);
+		return RTX_OK;
+}
+
+/* append a message, a priority mailbox files it by the sender's priority */
+int k_mbx_put(RB* rb, U32 length, const void *buf){
+		return k_mbx_put_at(rb,length,buf,k_msg_level(gp_current_task->prio));
+}
+
+/**************************************************************************//**
+ * @brief   copy the first n bytes of the next message without taking it
+ *****************************************************************************/
+void k_mbx_peek(RB* rb, void *buf, U32 n){
+		U32 roffset = rb->roffset;
+
+		if(rb->mode == MBX_PRIO){
+			cpymem(buf,MSG_NODE_DATA(k_mbx_front(rb)),n);
+			return;
+		}
+		read_rb(rb,n,buf);
+		rb->roffset = roffset;
+		rb->readsize -= n;
+}
+
+/**************************************************************************//**
+ * @brief   take the next message off a non-empty mailbox
+ * @param   buf     where to copy the message, NULL to discard it
+ *****************************************************************************/
+void k_mbx_pop(RB* rb, void *buf){
+		int length = get_msg_size(rb);
+		MSG_NODE *p_node;
+
+		U32 pad = MSG_RB_LEN(length) - length;
+
+		k_mbx_count_out(rb,length);
+		if(rb->mode != MBX_PRIO){
+			if(buf == NULL){
+				pad += length;
+			}else{
+				read_rb(rb,length,buf);
+			}
+			rb->roffset = (rb->roffset + pad) % rb->size;
+			rb->readsize += pad;
+			return;
+		}
+		p_node = k_mbx_front(rb);
+		for(int i = 0; i < 4; i++){
+			if(rb->pq_head[i] == p_node){
+				rb->pq_head[i] = p_node->next;
+				break;
+			}
+		}
+		if(buf != NULL){
+			cpymem(buf,MSG_NODE_DATA(p_node),length);
+		}
+		k_mpool_dealloc(MPID_IRAM2,p_node);
+		rb->readsize += length + pad;
+}
+
+/**************************************************************************//**
+ * @brief       switch a mailbox between FIFO and priority order
+ * @return      RTX_OK on success, RTX_ERR on failure
+ * @param       mbx     a mailbox of the calling task
+ * @param       mode    MBX_FIFO or MBX_PRIO
+ * @details     In MBX_PRIO mode messages are delivered by sender priority,
+ *              FIFO within a priority. Each message sits in its own node
+ *              instead of the ring, the mailbox size stays the byte budget.
+ *              The mailbox has to be empty.
+ *****************************************************************************/
+int k_mbx_set_mode(mbx_t mbx, int mode) {
+#ifdef DEBUG_0
+    printf("k_mbx_set_mode: mbx = %d, mode = %d\r\n", mbx, mode);
+#endif /* DEBUG_0 */
+		RB *p_mbx = k_mbx_lookup(mbx);
+
+		if(p_mbx == NULL){
+			return RTX_ERR;
+		}
+		if(p_mbx->owner != gp_current_task->tid){
+			errno = EPERM;
+			return RTX_ERR;
+		}
+		if(mode != MBX_FIFO && mode != MBX_PRIO){
+			errno = EINVAL;
+			return RTX_ERR;
+		}
+		if(!check_rb_empty(p_mbx)){
+			errno = EAGAIN;
+			return RTX_ERR;
+		}
+		if(mode == p_mbx->mode){
+			return RTX_OK;
+		}
+		if(mode == MBX_FIFO){
+			p_mbx->buffer = k_mpool_alloc(MPID_IRAM2, p_mbx->size);
+			if(p_mbx->buffer == NULL){
+				errno = ENOMEM;
+				return RTX_ERR;
+			}
+		}else{
+			k_mpool_dealloc(MPID_IRAM2,p_mbx->buffer);   // nodes are allocated per message
+			p_mbx->buffer = NULL;
+		}
+		init_rb(p_mbx,p_mbx->size);
+		p_mbx->mode = mode;
+		return RTX_OK;
+}
+
+/**************************************************************************//**
+ * @brief   admit as many blocked senders as the free space allows
+ * @details Senders are visited in priority order, FIFO within a priority.
+ *          Every sender whose message fits in the space left gets that
+ *          space reserved and is made ready, a sender that does not fit
+ *          does not hold back smaller messages behind it. The reservation
+ *          keeps new senders from taking the room before the admitted
+ *          ones get to run.
+ *****************************************************************************/
+void k_mbx_wake_sender(RB* rb){
+		int space = k_mbx_space(rb);
+
+		for(int i = 0; i < 4 && space >= MIN_MSG_SIZE; i++){
+			TCB *head = &rb->queue[i];
+			TCB *p_tcb = head->next;
+			while(p_tcb != head && space >= MIN_MSG_SIZE){
+				TCB *p_next = p_tcb->next;
+				int length = p_tcb->length_of_task_buf;
+				if(length <= space){
+					space -= length;
+					rb->reserved += length;
+					p_tcb->mbx_admit = rb - mailboxes;
+					q_delete_node(p_tcb);
+					p_tcb->state = READY;
+					q_add_to_list_last(p_tcb,&queue[p_tcb->prio-HIGH],queue[p_tcb->prio-HIGH].prev);
+				}
+				p_tcb = p_next;
+			}
+		}
+}
+
+/**************************************************************************//**
+ * @brief   copy the next message of a non-empty mailbox out to buf
+ * @return  RTX_OK on success, RTX_ERR with ENOSPC if buf is too small
+ * @note    a zero-copy record is resolved to its message, which is copied
+ *          and released, so plain receivers never see MSG_ZC records
+ *****************************************************************************/
+int k_mbx_read(RB* rb, void *buf, size_t len){
+		int length = get_msg_size(rb);
+		ZC_REC rec;
+
+		if(get_msg_type(rb) != MSG_ZC){
+			if(len<length){
+				errno = ENOSPC;
+				return RTX_ERR;
+			}
+			k_mbx_pop(rb,buf);
+			return RTX_OK;
+		}
+		k_mbx_peek(rb,&rec,sizeof(ZC_REC));
+		length = k_zc_length(rec.msg);
+		if(len<length){
+			errno = ENOSPC;     // the record stays queued
+			return RTX_ERR;
+		}
+		k_mbx_pop(rb,NULL);
+		cpymem(buf,rec.msg,length);
+		k_zc_put(rec.msg);
+		return RTX_OK;
+}
+
+/**************************************************************************//**
+ * @brief   discard every queued message, releasing zero-copy buffers
+ *****************************************************************************/
+void k_mbx_drain(RB* rb){
+		ZC_REC rec;
+
+		while(rb->size != 0 && !check_rb_empty(rb)){
+			if(get_msg_type(rb) == MSG_ZC){
+				k_mbx_peek(rb,&rec,sizeof(ZC_REC));
+				k_zc_put(rec.msg);
+			}
+			k_mbx_pop(rb,NULL);
+		}
+}
+
+/**************************************************************************//**
+ * @brief   make the task blocked receiving on the mailbox ready
+ *****************************************************************************/
+void k_mbx_wake_receiver(RB* rb){
+		TCB *p_tcb = rb->receiver;
+
+		if(p_tcb != NULL && p_tcb->state == BLK_RECV){
+			p_tcb->state = READY;
+			q_add_to_list_last(p_tcb,&queue[p_tcb->prio-HIGH],queue[p_tcb->prio-HIGH].prev);
+		}
+		rb->receiver = NULL;
+}
+
+/**************************************************************************//**
+ * @brief   queue a kernel-built message from interrupt context
+ * @return  RTX_OK, RTX_ERR if it does not fit right now
+ * @note    unlike k_mbx_send this never blocks and leaves errno, the drop
+ *          counter and the interrupted task alone. In a priority mailbox
+ *          the message goes to the most urgent level.
+ *****************************************************************************/
+int k_mbx_post(RB* rb, const void *buf){
+		U32 length = ((const RTX_MSG_HDR *)buf)->length;
+		int saved = errno;  // the allocator of a priority mailbox may set it
+		int ret;
+
+		if(rb->size == 0 || k_mbx_space(rb) < (int) MSG_RB_LEN(length) || !check_queue_empty(rb)){
+			return RTX_ERR;
+		}
+		ret = k_mbx_put_at(rb,length,buf,k_msg_level(HIGH));
+		errno = saved;
+		if(ret == RTX_OK){
+			k_mbx_wake_receiver(rb);
+		}
+		return ret;
+}
+
+/**************************************************************************//**
+ * @brief   common body of all send variants
+ * @param   timeout ticks to wait for room, 0 fails with ENOSPC right away,
+ *                  TMO_FOREVER blocks until the message fits
+ *****************************************************************************/
+int k_mbx_send(mbx_t mbx, const void *buf, U32 timeout) {
+		RB *p_mbx = k_mbx_lookup(mbx);
+		if(p_mbx == NULL){
+			return RTX_ERR;
+		}
+		if(buf==NULL){
+			errno = EFAULT;
+			return RTX_ERR;
+		}
+		int length = ((const RTX_MSG_HDR *)buf)->length;
+		int room = MSG_RB_LEN(length);      // what the message takes in the mailbox
+		if(length<MIN_MSG_SIZE){
+			errno = EINVAL;
+			return RTX_ERR;
+		}
+		if(room>p_mbx->size){
+			errno = EMSGSIZE;
+			return RTX_ERR;
+		}
+		gp_current_task->length_of_task_buf = room;
+		gp_current_task->timed_out = 0;
+		int cprio = gp_current_task->prio;
+	while(1){
+	if(p_mbx->size == 0){
+			k_tmo_cancel(gp_current_task);
+			errno = ENOENT;     // the mailbox got deleted while we were blocked
+			return RTX_ERR;
+	}
+	if(gp_current_task->mbx_admit == mbx){
+			gp_current_task->mbx_admit = -1;
+			p_mbx->reserved -= room;    // the room held for us is ours now
+			k_tmo_cancel(gp_current_task);
+			if(k_mbx_put(p_mbx,length,buf)!=RTX_OK){
+				return RTX_ERR;
+			}
+	}else if(k_mbx_space(p_mbx)>=room&&check_queue_empty(p_mbx)){
+			k_tmo_cancel(gp_current_task);
+			if(k_mbx_put(p_mbx,length,buf)!=RTX_OK){
+				return RTX_ERR;
+			}
+	}else if(timeout == 0){
+			p_mbx->nb_drops++;
+			errno = ENOSPC;
+			return RTX_ERR;
+	}else if(gp_current_task->timed_out){
+			errno = ETIMEDOUT;
+			return RTX_ERR;
+	}else{
+			if(timeout != TMO_FOREVER){
+				k_tmo_arm(gp_current_task, timeout);
+			}
+			gp_current_task->state = BLK_SEND;
+			gp_current_task->blk_since = g_timer_count;
+			q_add_to_list_last(gp_current_task,&(p_mbx->queue[cprio-HIGH]),p_mbx->queue[cprio-HIGH].prev);
+			k_tsk_run_new();
+			k_mbx_wait_done(&p_mbx->send_wait, gp_current_task->blk_since);
+			continue;
+		}
+	k_mbx_wake_receiver(p_mbx);
+    return RTX_OK;
+}
+}
+
+/**************************************************************************//**
+ * @brief   common body of all receive variants
+ * @param   timeout ticks to wait for a message, 0 fails with ENOMSG right
+ *                  away, TMO_FOREVER blocks until a message arrives
+ *****************************************************************************/
+int k_mbx_recv(mbx_t mbx, void *buf, size_t len, U32 timeout) {
+		RB *p_mbx = k_mbx_lookup(mbx);
+		if(p_mbx == NULL){
+			return RTX_ERR;
+		}
+		if(buf==NULL){
+			errno = EFAULT;
+			return RTX_ERR;
+		}
+		if(p_mbx->owner != gp_current_task->tid){
+			errno = EPERM;
+			return RTX_ERR;
+		}
+		if(k_mbx_wait(p_mbx, timeout)!=RTX_OK){
+			return RTX_ERR;
+		}
+		if(k_mbx_read(p_mbx,buf,len)!=RTX_OK){
+			return RTX_ERR;
+		}
+		k_mbx_wake_sender(p_mbx);
+    return RTX_OK;
+}
+
+/**************************************************************************//**
+ * @brief   block the caller until the mailbox holds a message
+ * @return  RTX_OK once a message is there, RTX_ERR with ENOMSG (timeout 0)
+ *          or ETIMEDOUT otherwise
+ *****************************************************************************/
+int k_mbx_wait(RB* rb, U32 timeout){
+		gp_current_task->timed_out = 0;
+		while(check_rb_empty(rb)){
+			if(timeout == 0){
+				errno = ENOMSG;
+				return RTX_ERR;
+			}
+			if(gp_current_task->timed_out){
+				errno = ETIMEDOUT;
+				return RTX_ERR;
+			}
+			if(timeout != TMO_FOREVER){
+				k_tmo_arm(gp_current_task, timeout);
+			}
+			rb->receiver = gp_current_task;
+			gp_current_task->state = BLK_RECV;
+			gp_current_task->blk_since = g_timer_count;
+			k_tsk_run_new();
+			k_mbx_wait_done(&rb->recv_wait, gp_current_task->blk_since);
+			if(rb->receiver == gp_current_task){
+				rb->receiver = NULL;    // woken by the timer, not by a sender
+			}
+		}
+		k_tmo_cancel(gp_current_task);
+		return RTX_OK;
+}
+
+int k_send_msg(task_t receiver_tid, const void *buf) {
+#ifdef DEBUG_0
+    printf("k_send_msg: receiver_tid = %d, buf=0x%x\r\n", receiver_tid, buf);
+#endif /* DEBUG_0 */
+		if(receiver_tid<1||receiver_tid>MAX_TASKS-1||g_tcbs[receiver_tid].state==DORMANT){
+			errno = EINVAL;
+			return RTX_ERR;
+		}
+		if(buf!=NULL && ((RTX_MSG_HDR *)buf)->type == MSG_ZC){
+			errno = EINVAL;     // zero-copy records are built by the kernel only
+			return RTX_ERR;
+		}
+		return k_mbx_send(receiver_tid,buf,TMO_FOREVER);
+}
+
+int k_send_msg_nb(task_t receiver_tid, const void *buf) {
+#ifdef DEBUG_0
+    printf("k_send_msg_nb: receiver_tid = %d, buf=0x%x\r\n", receiver_tid, buf);
+#endif /* DEBUG_0 */
+		if(receiver_tid<1||receiver_tid>MAX_TASKS-1||g_tcbs[receiver_tid].state==DORMANT){
+			errno = EINVAL;
+			return RTX_ERR;
+		}
+		if(buf!=NULL && ((RTX_MSG_HDR *)buf)->type == MSG_ZC){
+			errno = EINVAL;
+			return RTX_ERR;
+		}
+		return k_mbx_send(receiver_tid,buf,0);
+}
+
+int k_recv_msg(void *buf, size_t len) {
+#ifdef DEBUG_0
+    printf("k_recv_msg: buf=0x%x, len=%d\r\n", buf, len);
+#endif /* DEBUG_0 */
+		return k_mbx_recv(gp_current_task->tid,buf,len,TMO_FOREVER);
+}
+
+int k_recv_msg_nb(void *buf, size_t len) {
+#ifdef DEBUG_0
+    printf("k_recv_msg_nb: buf=0x%x, len=%d\r\n", buf, len);
+#endif /* DEBUG_0 */
+		return k_mbx_recv(gp_current_task->tid,buf,len,0);
+}
+
+/**************************************************************************//**
+ * @brief   send to a mailbox handle, see k_mbx_create_ex
+ *****************************************************************************/
+int k_send_msg_mbx(mbx_t mbx, const void *buf, U32 timeout) {
+#ifdef DEBUG_0
+    printf("k_send_msg_mbx: mbx = %d, buf=0x%x, timeout=%u\r\n", mbx, buf, timeout);
+#endif /* DEBUG_0 */
+		if(buf!=NULL && ((RTX_MSG_HDR *)buf)->type == MSG_ZC){
+			errno = EINVAL;
+			return RTX_ERR;
+		}
+		return k_mbx_send(mbx,buf,timeout);
+}
+
+/**************************************************************************//**
+ * @brief   receive from one specific mailbox of the calling task
+ *****************************************************************************/
+int k_recv_msg_mbx(mbx_t mbx, void *buf, size_t len, U32 timeout) {
+#ifdef DEBUG_0
+    printf("k_recv_msg_mbx: mbx = %d, buf=0x%x, len=%d, timeout=%u\r\n", mbx, buf, len, timeout);
+#endif /* DEBUG_0 */
+		return k_mbx_recv(mbx,buf,len,timeout);
+}
+
+/**************************************************************************//**
+ * @brief   convert a user timeout to ticks
+ * @return  TMO_FOREVER for NULL, otherwise the timeout rounded up to ticks
+ *****************************************************************************/
+U32 k_tv_to_ticks(TIMEVAL *p_tv) {
+		if(p_tv == NULL){
+			return TMO_FOREVER;
+		}
+		return p_tv->sec * (1000000 / RTX_TICK_SIZE) + (p_tv->usec + RTX_TICK_SIZE - 1) / RTX_TICK_SIZE;
+}
+
+/**************************************************************************//**
+ * @brief       send_msg that gives up after a timeout
+ * @return      RTX_OK on success, RTX_ERR with ETIMEDOUT if the message
+ *              did not fit into the mailbox in time
+ * @param       p_tv    how long to wait, NULL waits forever, {0, 0} does
+ *                      not wait at all
+ *****************************************************************************/
+int k_send_msg_timeout(task_t receiver_tid, const void *buf, TIMEVAL *p_tv) {
+#ifdef DEBUG_0
+    printf("k_send_msg_timeout: receiver_tid = %d, buf=0x%x, p_tv=0x%x\r\n", receiver_tid, buf, p_tv);
+#endif /* DEBUG_0 */
+		if(receiver_tid<1||receiver_tid>MAX_TASKS-1||g_tcbs[receiver_tid].state==DORMANT){
+			errno = EINVAL;
+			return RTX_ERR;
+		}
+		if(buf!=NULL && ((RTX_MSG_HDR *)buf)->type == MSG_ZC){
+			errno = EINVAL;
+			return RTX_ERR;
+		}
+		return k_mbx_send(receiver_tid,buf,k_tv_to_ticks(p_tv));
+}
+
+/**************************************************************************//**
+ * @brief       recv_msg that gives up after a timeout
+ * @return      RTX_OK on success, RTX_ERR with ETIMEDOUT if no message
+ *              arrived in time
+ * @param       p_tv    how long to wait, NULL waits forever, {0, 0} does
+ *                      not wait at all
+ *****************************************************************************/
+int k_recv_msg_timeout(void *buf, size_t len, TIMEVAL *p_tv) {
+#ifdef DEBUG_0
+    printf("k_recv_msg_timeout: buf=0x%x, len=%d, p_tv=0x%x\r\n", buf, len, p_tv);
+#endif /* DEBUG_0 */
+		return k_mbx_recv(gp_current_task->tid,buf,len,k_tv_to_ticks(p_tv));
+}
+
+/**************************************************************************//**
+ * @brief       wait until any of several mailboxes holds a message
+ * @return      index into handles of a non-empty mailbox, RTX_ERR on
+ *              failure (ENOMSG if none is ready and p_tv is {0, 0},
+ *              ETIMEDOUT if none became ready in time)
+ * @param       handles mailboxes of the calling task to watch
+ * @param       n       number of handles, at most MAX_MBX
+ * @param       p_tv    how long to wait, NULL waits forever
+ * @details     The task is registered as the receiver of each mailbox, so
+ *              the first send to any of them wakes it up. Registration and
+ *              cleanup are one pass over the handles each. The handles are
+ *              copied in once they passed the checks, a later write to
+ *              the user array has no effect. Each wait is counted in the
+ *              recv_wait stats of every mailbox watched. The message is
+ *              not consumed, follow up with recv_msg_mbx on the index.
+ *****************************************************************************/
+int k_mbx_select(mbx_t *handles, int n, TIMEVAL *p_tv) {
+#ifdef DEBUG_0
+    printf("k_mbx_select: handles=0x%x, n=%d, p_tv=0x%x\r\n", handles, n, p_tv);
+#endif /* DEBUG_0 */
+		U32 timeout = k_tv_to_ticks(p_tv);
+		RB *p_mbxs[MAX_MBX];
+		int i;
+
+		if(handles==NULL){
+			errno = EFAULT;
+			return RTX_ERR;
+		}
+		if(n<1||n>MAX_MBX){
+			errno = EINVAL;
+			return RTX_ERR;
+		}
+		for(i = 0; i < n; i++){
+			RB *p_mbx = k_mbx_lookup(handles[i]);
+			if(p_mbx == NULL){
+				return RTX_ERR;
+			}
+			if(p_mbx->owner != gp_current_task->tid){
+				errno = EPERM;
+				return RTX_ERR;
+			}
+			p_mbxs[i] = p_mbx;
+		}
+
+		gp_current_task->timed_out = 0;
+		while(1){
+			for(i = 0; i < n; i++){
+				if(!check_rb_empty(p_mbxs[i])){
+					k_tmo_cancel(gp_current_task);
+					return i;
+				}
+			}
+			if(timeout == 0){
+				errno = ENOMSG;
+				return RTX_ERR;
+			}
+			if(gp_current_task->timed_out){
+				errno = ETIMEDOUT;
+				return RTX_ERR;
+			}
+			if(timeout != TMO_FOREVER){
+				k_tmo_arm(gp_current_task, timeout);
+			}
+			for(i = 0; i < n; i++){
+				p_mbxs[i]->receiver = gp_current_task;
+			}
+			gp_current_task->state = BLK_RECV;
+			gp_current_task->blk_since = g_timer_count;
+			k_tsk_run_new();
+			for(i = 0; i < n; i++){
+				k_mbx_wait_done(&p_mbxs[i]->recv_wait, gp_current_task->blk_since);
+				if(p_mbxs[i]->receiver == gp_current_task){
+					p_mbxs[i]->receiver = NULL;
+				}
+			}
+		}
+}
+
+/**************************************************************************//**
+ * @brief       send several messages in one kernel entry
+ * @return      number of messages sent, RTX_ERR if not even the first one
+ *              could be sent
+ * @param       buf     count messages back to back, each one starting with
+ *                      its RTX_MSG_HDR, the next one MSG_RB_LEN(length)
+ *                      bytes after it
+ * @details     Each message is sent like send_msg, blocking while the
+ *              mailbox is full. The batch stops at the first message that
+ *              fails, errno tells why.
+ *****************************************************************************/
+int k_send_msg_batch(task_t receiver_tid, const void *buf, int count) {
+#ifdef DEBUG_0
+    printf("k_send_msg_batch: receiver_tid = %d, buf=0x%x, count=%d\r\n", receiver_tid, buf, count);
+#endif /* DEBUG_0 */
+		const U8 *p = buf;
+		int sent;
+
+		if(receiver_tid<1||receiver_tid>MAX_TASKS-1||g_tcbs[receiver_tid].state==DORMANT){
+			errno = EINVAL;
+			return RTX_ERR;
+		}
+		if(buf==NULL){
+			errno = EFAULT;
+			return RTX_ERR;
+		}
+		if(count<1){
+			errno = EINVAL;
+			return RTX_ERR;
+		}
+		for(sent = 0; sent < count; sent++){
+			if(((RTX_MSG_HDR *)p)->type == MSG_ZC){
+				errno = EINVAL;
+				break;
+			}
+			if(k_mbx_send(receiver_tid,p,TMO_FOREVER)!=RTX_OK){
+				break;
+			}
+			p += MSG_RB_LEN(((RTX_MSG_HDR *)p)->length);
+		}
+		return sent == 0 ? RTX_ERR : sent;
+}
+
+/**************************************************************************//**
+ * @brief   copy n bytes starting d bytes past the read end of a FIFO ring
+ *****************************************************************************/
+static void k_rb_copy_at(RB* rb, U32 d, void *buf, U32 n){
+		U8 *p = rb->buffer;
+		U32 off = (rb->roffset + d) % rb->size;
+		U32 first = rb->size - off;
+
+		if(n <= first){
+			cpymem(buf,p + off,n);
+		}else{
+			cpymem(buf,p + off,first);
+			cpymem((U8 *)buf + first,p,n - first);
+		}
+}
+
+/**************************************************************************//**
+ * @brief   drop the length byte message d bytes past the read end of a FIFO
+ *          ring, moving the d bytes in front of it up to close the gap
+ *****************************************************************************/
+static void k_rb_remove_at(RB* rb, U32 d, U32 length){
+		U8 *p = rb->buffer;
+
+		// back to front, in pieces that neither wrap nor overlap their target
+		while(d > 0){
+			U32 src = (rb->roffset + d) % rb->size;
+			U32 dst = (src + length) % rb->size;
+			U32 n = d < length ? d : length;
+
+			if(src == 0){
+				src = rb->size;
+			}
+			if(dst == 0){
+				dst = rb->size;
+			}
+			if(n > src){
+				n = src;
+			}
+			if(n > dst){
+				n = dst;
+			}
+			cpymem(p + dst - n,p + src - n,n);
+			d -= n;
+		}
+		rb->roffset = (rb->roffset + length) % rb->size;
+		rb->readsize += length;
+}
+
+/**************************************************************************//**
+ * @brief   is a message of this type selected by type_mask
+ * @param   p_hdr   header of the queued message, a zero-copy record is
+ *                  judged by the message it points to
+ *****************************************************************************/
+static const RTX_MSG_HDR *k_msg_resolve(const RTX_MSG_HDR *p_hdr, const void *p_raw){
+		if(p_hdr->type == MSG_ZC){
+			return (const RTX_MSG_HDR *)((const ZC_REC *)p_raw)->msg;
+		}
+		return p_hdr;
+}
+
+static BOOL k_msg_match(U8 type, U32 type_mask){
+		return type < 32 && (type_mask & (1UL << type)) != 0;
+}
+
+/**************************************************************************//**
+ * @brief   take the first queued message whose type is in type_mask
+ * @return  RTX_OK on success, RTX_ERR with ENOMSG if none matches or
+ *          ENOSPC if the match does not fit in buf (it stays queued)
+ * @note    messages in front of the match keep their order
+ *****************************************************************************/
+int k_mbx_take_type(RB* rb, U32 type_mask, void *buf, size_t len){
+		const RTX_MSG_HDR *p_msg;
+		ZC_REC rec;
+		U32 length;
+
+		if(rb->mode == MBX_PRIO){
+			for(int i = 0; i < 4; i++){
+				MSG_NODE *p_prev = NULL;
+				for(MSG_NODE *p_node = rb->pq_head[i]; p_node != NULL; p_prev = p_node, p_node = p_node->next){
+					RTX_MSG_HDR *p_hdr = (RTX_MSG_HDR *)MSG_NODE_DATA(p_node);
+					p_msg = k_msg_resolve(p_hdr, p_hdr);
+					if(!k_msg_match(p_msg->type, type_mask)){
+						continue;
+					}
+					length = p_msg == p_hdr ? p_hdr->length : k_zc_length(p_msg);
+					if(len < length){
+						errno = ENOSPC;
+						return RTX_ERR;
+					}
+					cpymem(buf,p_msg,length);
+					if(p_msg != p_hdr){
+						k_zc_put((void *)p_msg);
+					}
+					if(p_prev == NULL){
+						rb->pq_head[i] = p_node->next;
+					}else{
+						p_prev->next = p_node->next;
+					}
+					if(rb->pq_tail[i] == p_node){
+						rb->pq_tail[i] = p_prev;
+					}
+					rb->readsize += MSG_RB_LEN(p_hdr->length);
+					k_mbx_count_out(rb,p_hdr->length);
+					k_mpool_dealloc(MPID_IRAM2,p_node);
+					return RTX_OK;
+				}
+			}
+			errno = ENOMSG;
+			return RTX_ERR;
+		}
+		for(U32 d = 0; d < rb->writesize - rb->readsize; d += MSG_RB_LEN(rec.hdr.length)){
+			k_rb_copy_at(rb,d,&rec,MSG_HDR_SIZE);
+			if(rec.hdr.type == MSG_ZC){
+				k_rb_copy_at(rb,d,&rec,sizeof(ZC_REC));
+			}
+			p_msg = k_msg_resolve(&rec.hdr, &rec);
+			if(!k_msg_match(p_msg->type, type_mask)){
+				continue;
+			}
+			length = p_msg == &rec.hdr ? rec.hdr.length : k_zc_length(p_msg);
+			if(len < length){
+				errno = ENOSPC;
+				return RTX_ERR;
+			}
+			if(p_msg != &rec.hdr){
+				cpymem(buf,p_msg,length);
+				k_zc_put((void *)p_msg);
+			}else{
+				k_rb_copy_at(rb,d,buf,rec.hdr.length);
+			}
+			k_rb_remove_at(rb,d,MSG_RB_LEN(rec.hdr.length));
+			k_mbx_count_out(rb,rec.hdr.length);
+			return RTX_OK;
+		}
+		errno = ENOMSG;
+		return RTX_ERR;
+}
+
+/**************************************************************************//**
+ * @brief       receive the first message of a selected type, blocking until
+ *              one is there
+ * @return      RTX_OK on success, RTX_ERR on failure (ENOMSG if none
+ *              matches and p_tv is {0, 0}, ETIMEDOUT if none arrived in
+ *              time, EAGAIN if none matches and the mailbox is too full
+ *              for another message to arrive)
+ * @param       type_mask   bit n selects message type n, types 0 to 31
+ * @param       p_tv        how long to wait, NULL waits forever
+ * @details     Other messages stay queued in their order. Each arrival
+ *              wakes the caller to look again.
+ *****************************************************************************/
+int k_recv_msg_type(U32 type_mask, void *buf, size_t len, TIMEVAL *p_tv) {
+#ifdef DEBUG_0
+    printf("k_recv_msg_type: type_mask = 0x%x, buf=0x%x, len=%d, p_tv=0x%x\r\n", type_mask, buf, len, p_tv);
+#endif /* DEBUG_0 */
+		RB *p_mbx = k_mbx_lookup(gp_current_task->tid);
+		U32 timeout = k_tv_to_ticks(p_tv);
+
+		if(p_mbx == NULL){
+			return RTX_ERR;
+		}
+		if(buf == NULL){
+			errno = EFAULT;
+			return RTX_ERR;
+		}
+		if(type_mask == 0){
+			errno = EINVAL;
+			return RTX_ERR;
+		}
+		gp_current_task->timed_out = 0;
+		while(k_mbx_take_type(p_mbx,type_mask,buf,len) != RTX_OK){
+			if(errno != ENOMSG){
+				k_tmo_cancel(gp_current_task);
+				return RTX_ERR;
+			}
+			if(!check_queue_empty(p_mbx) || k_mbx_space(p_mbx) < (int) MSG_RB_LEN(MIN_MSG_SIZE)){
+				k_tmo_cancel(gp_current_task);
+				errno = EAGAIN;     // nothing can arrive before something is read
+				return RTX_ERR;
+			}
+			if(timeout == 0){
+				return RTX_ERR;     // ENOMSG
+			}
+			if(gp_current_task->timed_out){
+				errno = ETIMEDOUT;
+				return RTX_ERR;
+			}
+			if(timeout != TMO_FOREVER){
+				k_tmo_arm(gp_current_task, timeout);
+			}
+			p_mbx->receiver = gp_current_task;
+			gp_current_task->state = BLK_RECV;
+			gp_current_task->blk_since = g_timer_count;
+			k_tsk_run_new();
+			k_mbx_wait_done(&p_mbx->recv_wait, gp_current_task->blk_since);
+			if(p_mbx->receiver == gp_current_task){
+				p_mbx->receiver = NULL;    // woken by the timer, not by a sender
+			}
+		}
+		k_tmo_cancel(gp_current_task);
+		k_mbx_wake_sender(p_mbx);
+		return RTX_OK;
+}
+
+/**************************************************************************//**
+ * @brief       copy the header of the next message without taking it
+ * @return      RTX_OK on success, RTX_ERR with ENOMSG if the mailbox is empty
+ * @param       hdr     receives the header, for a zero-copy message the
+ *                      header of the message it refers to, so hdr->length
+ *                      is the buffer size recv_msg needs
+ *****************************************************************************/
+int k_mbx_peek_msg(mbx_t mbx, RTX_MSG_HDR *hdr) {
+#ifdef DEBUG_0
+    printf("k_mbx_peek_msg: mbx = %d, hdr=0x%x\r\n", mbx, hdr);
+#endif /* DEBUG_0 */
+		RB *p_mbx = k_mbx_lookup(mbx);
+		ZC_REC rec;
+
+		if(p_mbx == NULL){
+			return RTX_ERR;
+		}
+		if(hdr == NULL){
+			errno = EFAULT;
+			return RTX_ERR;
+		}
+		if(p_mbx->owner != gp_current_task->tid){
+			errno = EPERM;
+			return RTX_ERR;
+		}
+		if(check_rb_empty(p_mbx)){
+			errno = ENOMSG;
+			return RTX_ERR;
+		}
+		if(get_msg_type(p_mbx) == MSG_ZC){
+			k_mbx_peek(p_mbx,&rec,sizeof(ZC_REC));
+			cpymem(hdr,rec.msg,MSG_HDR_SIZE);
+			hdr->length = k_zc_length(rec.msg);
+		}else{
+			k_mbx_peek(p_mbx,hdr,MSG_HDR_SIZE);
+		}
+		return RTX_OK;
+}
+
+/**************************************************************************//**
+ * @brief       receive several messages in one kernel entry
+ * @return      number of messages received, RTX_ERR on failure
+ * @param       buf     receives the messages back to back, each one
+ *                      MSG_RB_LEN(length) bytes after the one before
+ * @param       len     size of buf in bytes
+ * @param       max     most messages to take
+ * @details     Blocks like recv_msg until there is a message, then keeps
+ *              taking queued messages without blocking while they fit in
+ *              buf.
+ *****************************************************************************/
+int k_recv_msg_batch(void *buf, size_t len, int max) {
+#ifdef DEBUG_0
+    printf("k_recv_msg_batch: buf=0x%x, len=%d, max=%d\r\n", buf, len, max);
+#endif /* DEBUG_0 */
+		RB *p_mbx = k_mbx_lookup(gp_current_task->tid);
+		U8 *p = buf;
+		U32 used;
+		int got;
+
+		if(p_mbx == NULL){
+			return RTX_ERR;
+		}
+		if(buf==NULL){
+			errno = EFAULT;
+			return RTX_ERR;
+		}
+		if(max<1){
+			errno = EINVAL;
+			return RTX_ERR;
+		}
+		// k_mbx_recv without its admission pass, the one below covers all
+		if(k_mbx_wait(p_mbx,TMO_FOREVER)!=RTX_OK||k_mbx_read(p_mbx,buf,len)!=RTX_OK){
+			return RTX_ERR;
+		}
+		used = MSG_RB_LEN(((RTX_MSG_HDR *)p)->length);
+		for(got = 1; got < max && used < len && !check_rb_empty(p_mbx); got++){
+			if(k_mbx_read(p_mbx,p + used,len - used)!=RTX_OK){
+				break;      // the next message does not fit, it stays queued
+			}
+			used += MSG_RB_LEN(((RTX_MSG_HDR *)(p + used))->length);
+		}
+		k_mbx_wake_sender(p_mbx);       // one admission pass for all the room freed
+		return got;
+}
+
+/**************************************************************************//**
+ * @brief       send a request and block until the server replies
+ * @return      RTX_OK once the reply is in reply_buf, RTX_ERR on failure
+ * @param       server      the task serving the request
+ * @param       req         request message, queued to the server mailbox
+ * @param       reply_buf   receives the reply message
+ * @param       len         size of reply_buf in bytes
+ * @details     The server takes the request with recv_msg and answers
+ *              with msg_reply to the request's sender_tid. The kernel
+ *              copies the reply straight into reply_buf, no mailbox is
+ *              needed on the client side. Both legs hand the cpu over
+ *              directly when the priorities allow it.
+ *****************************************************************************/
+int k_msg_call(task_t server, const void *req, void *reply_buf, size_t len) {
+#ifdef DEBUG_0
+    printf("k_msg_call: server = %d, req=0x%x, reply_buf=0x%x, len=%d\r\n", server, req, reply_buf, len);
+#endif /* DEBUG_0 */
+		if(server<1||server>MAX_TASKS-1||g_tcbs[server].state==DORMANT||server==gp_current_task->tid){
+			errno = EINVAL;
+			return RTX_ERR;
+		}
+		if(reply_buf==NULL){
+			errno = EFAULT;
+			return RTX_ERR;
+		}
+		if(len<MIN_MSG_SIZE){
+			errno = EINVAL;
+			return RTX_ERR;
+		}
+		if(k_send_msg(server,req)!=RTX_OK){
+			return RTX_ERR;
+		}
+		gp_current_task->rpc_buf = reply_buf;
+		gp_current_task->rpc_len = len;
+		gp_current_task->rpc_server = server;
+		gp_current_task->rpc_err = 0;
+		gp_current_task->state = BLK_CALL;
+		if(g_tcbs[server].state == READY){
+			k_tsk_handoff(&g_tcbs[server]);
+		}else{
+			k_tsk_run_new();
+		}
+		gp_current_task->rpc_buf = NULL;
+		if(gp_current_task->rpc_err != 0){
+			errno = gp_current_task->rpc_err;
+			return RTX_ERR;
+		}
+		return RTX_OK;
+}
+
+/**************************************************************************//**
+ * @brief       answer a pending msg_call
+ * @return      RTX_OK on success, RTX_ERR on failure
+ * @param       client  the caller, blocked in msg_call on this task
+ * @param       reply   reply message
+ * @note        a reply longer than the client buffer fails with EMSGSIZE
+ *              here and with ENOSPC in the client
+ *****************************************************************************/
+int k_msg_reply(task_t client, const void *reply) {
+#ifdef DEBUG_0
+    printf("k_msg_reply: client = %d, reply=0x%x\r\n", client, reply);
+#endif /* DEBUG_0 */
+		TCB *p_tcb;
+		U32 length;
+		int fits;
+
+		if(client<1||client>MAX_TASKS-1){
+			errno = EINVAL;
+			return RTX_ERR;
+		}
+		if(reply==NULL){
+			errno = EFAULT;
+			return RTX_ERR;
+		}
+		p_tcb = &g_tcbs[client];
+		if(p_tcb->state != BLK_CALL || p_tcb->rpc_server != gp_current_task->tid){
+			errno = ENOENT;     // no call of this client is pending on us
+			return RTX_ERR;
+		}
+		length = ((RTX_MSG_HDR *)reply)->length;
+		if(length<MIN_MSG_SIZE){
+			errno = EINVAL;
+			return RTX_ERR;
+		}
+		fits = length <= p_tcb->rpc_len;
+		if(fits){
+			cpymem(p_tcb->rpc_buf,reply,length);
+		}else{
+			p_tcb->rpc_err = ENOSPC;
+		}
+		p_tcb->state = READY;
+		q_add_to_list_last(p_tcb,&queue[p_tcb->prio-HIGH],queue[p_tcb->prio-HIGH].prev);
+		k_tsk_handoff(p_tcb);
+		if(!fits){
+			errno = EMSGSIZE;
+			return RTX_ERR;
+		}
+		return RTX_OK;
+}
+
+/**************************************************************************//**
+ * @brief   fail every msg_call pending on server with ENOENT, used on exit
+ *****************************************************************************/
+void k_msg_call_abort(task_t server) {
+		for(int i = 1; i < MAX_TASKS; i++){
+			TCB *p_tcb = &g_tcbs[i];
+			if(p_tcb->state == BLK_CALL && p_tcb->rpc_server == server){
+				p_tcb->rpc_err = ENOENT;
+				p_tcb->state = READY;
+				q_add_to_list_last(p_tcb,&queue[p_tcb->prio-HIGH],queue[p_tcb->prio-HIGH].prev);
+			}
+		}
+}
+
+ZC_BUF g_zc_bufs[MAX_ZC_BUFS];          // every live k_msg_alloc buffer
+
+/**************************************************************************//**
+ * @brief   the kernel record of a live k_msg_alloc buffer
+ * @return  the record, NULL if msg is not such a buffer
+ *****************************************************************************/
+ZC_BUF *k_zc_lookup(const void *msg) {
+		if(msg == NULL){
+			return NULL;
+		}
+		for(int i = 0; i < MAX_ZC_BUFS; i++){
+			if(g_zc_bufs[i].msg == msg){
+				return &g_zc_bufs[i];
+			}
+		}
+		return NULL;
+}
+
+/* length of a queued zero-copy message, as checked when it was sent */
+U32 k_zc_length(const void *msg) {
+		return k_zc_lookup(msg)->length;
+}
+
+/**************************************************************************//**
+ * @brief       allocate a message buffer for zero-copy passing
+ * @return      the message, header first, or NULL with errno set
+ * @param       size    message length including the header
+ * @details     The buffer is owned by the calling task. send_msg_zc hands
+ *              it over to the receiver, the final owner calls msg_free.
+ *              Owner, size and references are kept in g_zc_bufs where the
+ *              tasks cannot write them.
+ *****************************************************************************/
+void *k_msg_alloc(size_t size) {
+#ifdef DEBUG_0
+    printf("k_msg_alloc: size = %u\r\n", size);
+#endif /* DEBUG_0 */
+		ZC_BUF *p_zc = NULL;
+
+		if(size<MIN_MSG_SIZE){
+			errno = EINVAL;
+			return NULL;
+		}
+		for(int i = 0; i < MAX_ZC_BUFS && p_zc == NULL; i++){
+			if(g_zc_bufs[i].msg == NULL){
+				p_zc = &g_zc_bufs[i];
+			}
+		}
+		if(p_zc == NULL){
+			errno = ENOMEM;
+			return NULL;
+		}
+		p_zc->msg = k_mpool_alloc(MPID_IRAM2, size);
+		if(p_zc->msg == NULL){
+			errno = ENOMEM;
+			return NULL;
+		}
+		p_zc->size = size;
+		p_zc->length = 0;
+		p_zc->owner = gp_current_task->tid;
+		p_zc->refcnt = 1;
+		setmem(p_zc->holds,0,sizeof(p_zc->holds));
+		return p_zc->msg;
+}
+
+/**************************************************************************//**
+ * @brief   drop one reference to a zero-copy buffer, freeing it on the last
+ *****************************************************************************/
+void k_zc_put(void *msg) {
+		ZC_BUF *p_zc = k_zc_lookup(msg);
+
+		if(--p_zc->refcnt == 0){
+			k_mpool_dealloc(MPID_IRAM2, p_zc->msg);
+			p_zc->msg = NULL;
+		}
+}
+
+/**************************************************************************//**
+ * @brief   drop the buffers an exiting task owns and the shared buffer
+ *          references it still holds
+ * @note    called after its mailboxes were drained, so a buffer it owns is
+ *          one in its hands, not one queued to it
+ *****************************************************************************/
+void k_zc_release_task(task_t tid) {
+		for(int i = 0; i < MAX_ZC_BUFS; i++){
+			ZC_BUF *p_zc = &g_zc_bufs[i];
+			if(p_zc->msg != NULL && p_zc->owner == tid){
+				k_zc_put(p_zc->msg);
+			}
+			while(p_zc->msg != NULL && p_zc->holds[tid] > 0){
+				p_zc->holds[tid]--;
+				k_zc_put(p_zc->msg);
+			}
+		}
+}
+
+/**************************************************************************//**
+ * @brief   check that msg is a live k_msg_alloc buffer owned by the caller
+ * @param   shared_ok   also accept a shared (published) buffer the caller
+ *                      received and has not released yet
+ *****************************************************************************/
+int k_msg_check(void *msg, int shared_ok) {
+		ZC_BUF *p_zc;
+
+		if(msg==NULL){
+			errno = EFAULT;
+			return RTX_ERR;
+		}
+		p_zc = k_zc_lookup(msg);
+		if(p_zc == NULL){
+			errno = EINVAL;
+			return RTX_ERR;
+		}
+		if(p_zc->owner == ZC_SHARED){
+			if(!shared_ok || p_zc->holds[gp_current_task->tid] == 0){
+				errno = EPERM;
+				return RTX_ERR;
+			}
+			return RTX_OK;
+		}
+		if(p_zc->owner != gp_current_task->tid){
+			errno = EPERM;
+			return RTX_ERR;
+		}
+		return RTX_OK;
+}
+
+int k_msg_free(void *msg) {
+#ifdef DEBUG_0
+    printf("k_msg_free: msg = 0x%x\r\n", msg);
+#endif /* DEBUG_0 */
+		if(k_msg_check(msg,1)!=RTX_OK){
+			return RTX_ERR;
+		}
+		if(k_zc_lookup(msg)->owner == ZC_SHARED){
+			k_zc_lookup(msg)->holds[gp_current_task->tid]--;    // one release per reference received
+		}
+		k_zc_put(msg);
+		return RTX_OK;
+}
+
+/**************************************************************************//**
+ * @brief       send a k_msg_alloc buffer by reference
+ * @return      RTX_OK on success, RTX_ERR on failure
+ * @details     Only a small pointer record goes through the receiver ring.
+ *              The buffer changes owner and the sender must not touch it
+ *              after a successful send. The length in the header is
+ *              checked against the allocation here and receivers copy that
+ *              checked length, not whatever the header holds later.
+ *****************************************************************************/
+int k_send_msg_zc(task_t receiver_tid, void *msg) {
+#ifdef DEBUG_0
+    printf("k_send_msg_zc: receiver_tid = %d, msg=0x%x\r\n", receiver_tid, msg);
+#endif /* DEBUG_0 */
+		ZC_REC rec;
+		ZC_BUF *p_zc;
+		U32 length;
+
+		if(receiver_tid<1||receiver_tid>MAX_TASKS-1||g_tcbs[receiver_tid].state==DORMANT){
+			errno = EINVAL;
+			return RTX_ERR;
+		}
+		if(k_msg_check(msg,0)!=RTX_OK){
+			return RTX_ERR;
+		}
+		p_zc = k_zc_lookup(msg);
+		length = ((RTX_MSG_HDR *)msg)->length;
+		if(length<MIN_MSG_SIZE||length>p_zc->size){
+			errno = EINVAL;
+			return RTX_ERR;
+		}
+		rec.hdr.length = sizeof(ZC_REC);
+		rec.hdr.sender_tid = gp_current_task->tid;
+		rec.hdr.type = MSG_ZC;
+		rec.msg = msg;
+		p_zc->length = length;
+		if(k_mbx_send(receiver_tid,&rec,TMO_FOREVER)!=RTX_OK){
+			return RTX_ERR;
+		}
+		p_zc->owner = receiver_tid;     // only once queued, a receiver exiting meanwhile must not free it
+		return RTX_OK;
+}
+
+/**************************************************************************//**
+ * @brief       receive the next message by reference, blocking when empty
+ * @return      RTX_OK on success, RTX_ERR on failure
+ * @param       p_msg   output, the message now owned by the caller
+ * @details     A message that was sent by copy is moved into a fresh
+ *              k_msg_alloc buffer so the caller always frees with msg_free.
+ *              A topic message is shared with the other subscribers and
+ *              must not be written to, msg_free drops only this reference.
+ *****************************************************************************/
+int k_recv_msg_zc(void **p_msg) {
+#ifdef DEBUG_0
+    printf("k_recv_msg_zc: p_msg=0x%x\r\n", p_msg);
+#endif /* DEBUG_0 */
+		RB *p_mbx = k_mbx_lookup(gp_current_task->tid);
+		ZC_REC rec;
+
+		if(p_mbx==NULL){
+			return RTX_ERR;
+		}
+		if(p_msg==NULL){
+			errno = EFAULT;
+			return RTX_ERR;
+		}
+		k_mbx_wait(p_mbx, TMO_FOREVER);
+		if(get_msg_type(p_mbx) == MSG_ZC){
+			k_mbx_pop(p_mbx,&rec);
+			if(k_zc_lookup(rec.msg)->owner == ZC_SHARED){
+				k_zc_lookup(rec.msg)->holds[gp_current_task->tid]++;    // the queued reference is ours now
+			}
+			*p_msg = rec.msg;
+		}else{
+			int length = get_msg_size(p_mbx);
+			void *msg = k_msg_alloc(length);
+			if(msg==NULL){
+				return RTX_ERR;
+			}
+			k_mbx_pop(p_mbx,msg);
+			k_zc_lookup(msg)->length = length;
+			*p_msg = msg;
+		}
+		k_mbx_wake_sender(p_mbx);
+		return RTX_OK;
+}
+int k_recv_uart(U8* buf, size_t len){
+		if(!check_rb_empty(&uart_mb)){
+			k_mbx_pop(&uart_mb,buf);
+			return RTX_OK;
+	}else{
+			return RTX_ERR;
+	}
+}
+int k_send_to_uart(const void* buf){
+		int length = ((const RTX_MSG_HDR *)buf)->length;
+		gp_current_task->length_of_task_buf = length;
+	int free_size = get_rb_free_size(&uart_mb);
+	if(free_size>=MSG_RB_LEN(length)){
+			k_mbx_put(&uart_mb,length,buf);
+	}else{
+			errno = ENOSPC;
+			return RTX_ERR;
+		}
+		//TCB* waiting_recv = get_waiting_highest(receiver_tid,BLK_RECV);
+
+    return RTX_OK;
+}
+int k_mbx_ls(task_t *buf, size_t count) {
+#ifdef DEBUG_0
+    printf("k_mbx_ls: buf=0x%x, count=%u\r\n", buf, count);
+#endif /* DEBUG_0 */
+	if(buf==NULL||count==0){
+		errno = EFAULT;
+		return -1;
+	}
+    return bm_list(g_mbx_map, MAX_TASKS, buf, count);
+}
+
+int k_mbx_get(task_t tid)
+{
+#ifdef DEBUG_0
+    printf("k_mbx_get: tid=%u\r\n", tid);
+#endif /* DEBUG_0 */
+		if(tid >= MAX_TASKS){
+			errno = EINVAL;
+			return RTX_ERR;
+		}
+		if(mailboxes[tid].size == 0){
+			errno = ENOENT;
+			return RTX_ERR;
+		}
+		return get_rb_free_size(&mailboxes[tid]);
+}
+
+/**************************************************************************//**
+ * @brief       copy the counters of a mailbox
+ * @return      RTX_OK on success, RTX_ERR on failure
+ * @param       mbx     any existing mailbox
+ * @param       buf     receives the counters, kept since the mailbox was
+ *                      created
+ * @details     Byte counts are what the messages take in the mailbox, a
+ *              zero-copy message counts as its pointer record.
+ *****************************************************************************/
+int k_mbx_stat(mbx_t mbx, MBX_STAT *buf)
+{
+#ifdef DEBUG_0
+    printf("k_mbx_stat: mbx=%d, buf=0x%x\r\n", mbx, buf);
+#endif /* DEBUG_0 */
+		RB *p_mbx = k_mbx_lookup(mbx);
+
+		if(p_mbx == NULL){
+			return RTX_ERR;
+		}
+		if(buf == NULL){
+			errno = EFAULT;
+			return RTX_ERR;
+		}
+		buf->size = p_mbx->size;
+		buf->used = p_mbx->writesize - p_mbx->readsize;
+		buf->peak = p_mbx->peak;
+		buf->msgs_in = p_mbx->msgs_in;
+		buf->bytes_in = p_mbx->bytes_in;
+		buf->msgs_out = p_mbx->msgs_out;
+		buf->bytes_out = p_mbx->bytes_out;
+		buf->nb_drops = p_mbx->nb_drops;
+		buf->send_blocks = p_mbx->send_wait.count;
+		buf->send_ticks = p_mbx->send_wait.ticks;
+		buf->send_max = p_mbx->send_wait.max;
+		buf->recv_blocks = p_mbx->recv_wait.count;
+		buf->recv_ticks = p_mbx->recv_wait.ticks;
+		buf->recv_max = p_mbx->recv_wait.max;
+		return RTX_OK;
+}
+#ifdef MBX_BENCH
+/**************************************************************************//**
+ * @brief   cycles elapsed between two TIMER1 readings
+ * @note    TIMER1 runs from CCLK, so PC counts cpu cycles and TC seconds
+ *****************************************************************************/
+static U32 bench_cycles(TM_TICK *tk1, TM_TICK *tk2)
+{
+    return (tk2->tc - tk1->tc) * 100000000 + tk2->pc - tk1->pc;
+}
+
+static void cpymem_bytes(void *dest, const void *src, size_t count)
+{
+    char *tmp = dest;
+    const char *s = src;
+    while (count--)
+        *tmp++ = *s++;
+}
+
+/**************************************************************************//**
+ * @brief   message ring copy microbenchmark
+ * @details Pushes messages of several sizes through a scratch ring with
+ *          write_rb/read_rb and reports bytes per 100 cycles for the
+ *          aligned and the unaligned case, next to the old byte loop.
+ *          Build with MBX_BENCH defined, results go to the debug UART.
+ *****************************************************************************/
+void k_mbx_bench(void)
+{
+    static const U32 sizes[] = {8, 32, 128, 512};
+    RB   rb;
+    TM_TICK tk1, tk2;
+    U8  *src = k_mpool_alloc(MPID_IRAM2, 1024);
+    U8  *dst = k_mpool_alloc(MPID_IRAM2, 1024);
+
+    rb.buffer = k_mpool_alloc(MPID_IRAM2, 1024 + 4);
+    if (src == NULL || dst == NULL || rb.buffer == NULL) {
+        printf("k_mbx_bench: out of memory\r\n");
+        return;
+    }
+    printf("size  align  ring B/100cyc  byte-loop B/100cyc\r\n");
+    for (int i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        for (int align = 0; align < 2; align++) {
+            U32 bytes = sizes[i] * MBX_BENCH_ITER;
+            U32 c_new, c_old;
+
+            init_rb(&rb, 1024 + 4);         // not a multiple of the message size, so the wrap path is exercised
+            get_tick(&tk1, TIMER1);
+            for (int n = 0; n < MBX_BENCH_ITER; n++) {
+                write_rb(&rb, sizes[i], src + align);
+                read_rb(&rb, sizes[i], dst + align);
+            }
+            get_tick(&tk2, TIMER1);
+            c_new = bench_cycles(&tk1, &tk2);
+
+            get_tick(&tk1, TIMER1);
+            for (int n = 0; n < MBX_BENCH_ITER; n++) {
+                cpymem_bytes(rb.buffer, src + align, sizes[i]);
+                cpymem_bytes(dst + align, rb.buffer, sizes[i]);
+            }
+            get_tick(&tk2, TIMER1);
+            c_old = bench_cycles(&tk1, &tk2);
+
+            printf("%4u  %5d  %13u  %18u\r\n", sizes[i], align,
+                   bytes * 2 * 100 / c_new, bytes * 2 * 100 / c_old);
+        }
+    }
+    k_mpool_dealloc(MPID_IRAM2, rb.buffer);
+    k_mpool_dealloc(MPID_IRAM2, dst);
+    k_mpool_dealloc(MPID_IRAM2, src);
+}
+#endif /* MBX_BENCH */
+
+/*
+ *===========================================================================
+ *                             END OF FILE
+ *===========================================================================
+ */
+
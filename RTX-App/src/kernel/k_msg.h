@@ -1,62 +1,138 @@
-/*
- ****************************************************************************
- *
- *                  UNIVERSITY OF WATERLOO ECE 350 RTOS LAB
- *
- *                     Copyright 2020-2022 Yiqing Huang
- *                          All rights reserved.
- *
- *  Redistribution and use in source and binary forms, with or without
- *  modification, are permitted provided that the following conditions are met:
- *  - Redistributions of source code must retain the above copyright
- *    notice and the following disclaimer.
- *
- *
- *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
- *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
- *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
- *  ARE DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS AND CONTRIBUTORS BE
- *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
- *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
- *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
- *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
- *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
- *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
- *  POSSIBILITY OF SUCH DAMAGE.
- ****************************************************************************
- */
-
-/**************************************************************************//**
- * @file        k_msg.h
- * @brief       kernel message passing header file
- *
- * @version     V1.2021.06
- * @authors     Yiqing Huang
- * @date        2021 JUN
- *****************************************************************************/
-
- 
-#ifndef K_MSG_H_
-#define K_MSG_H_
-
-#include "k_inc.h"
-extern RB mailboxes[MAX_TASKS];
-void init_rb (RB* rb, U32 size);
-int k_mbx_create    (size_t size);
-int k_send_msg      (task_t receiver_tid, const void *buf);
-int k_send_msg_nb   (task_t receiver_tid, const void *buf);
-int k_recv_msg      (void *buf, size_t len);
-int k_recv_msg_nb   (void *buf, size_t len);
-int k_mbx_ls        (task_t *buf, size_t count);
-int k_mbx_get       (task_t tid);
-int get_msg_size(RB* rb);
-int k_recv_uart(U8* buf, size_t len);
-int k_send_to_uart(const void* buf);
-#endif // ! K_MSG_H_
-
-/*
- *===========================================================================
- *                             END OF FILE
- *===========================================================================
- */
-
+/*
+ ****************************************************************************
+ *
+ *                  UNIVERSITY OF WATERLOO ECE 350 RTOS LAB
+ *
+ *                     Copyright 2020-2022 Yiqing Huang
+ *                          All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice and the following disclaimer.
+ *
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS AND CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ ****************************************************************************
+ */
+
+/**************************************************************************//**
+ * @file        k_msg.h
+ * @brief       kernel message passing header file
+ *
+ * @version     V1.2021.06
+ * @authors     Yiqing Huang
+ * @date        2021 JUN
+ *****************************************************************************/
+
+ 
+#ifndef K_MSG_H_
+#define K_MSG_H_
+
+#include "k_inc.h"
+
+#define MSG_ZC      0xFF        /* internal type of a zero-copy pointer record */
+#define ZC_SHARED   TID_UNK     /* owner of a published buffer, read-only for all */
+
+/* kernel record of a k_msg_alloc buffer, the buffer itself is all message */
+typedef struct zc_buf {
+    void       *msg;            /**< the buffer, NULL for a free slot         */
+    U32         size;           /**< bytes allocated                          */
+    U32         length;         /**< message length checked when it was sent  */
+    task_t      owner;          /**< task allowed to send or free the message */
+    U16         refcnt;         /**< references, queued records included      */
+    U8          holds[MAX_TASKS];   /**< shared buffer references received by each task */
+} ZC_BUF;
+
+/* what a zero-copy send actually puts into the receiver ring */
+typedef __packed struct zc_rec {
+    RTX_MSG_HDR hdr;            /**< length = sizeof(ZC_REC), type = MSG_ZC   */
+    void        *msg;           /**< the k_msg_alloc buffer                   */
+} ZC_REC;
+
+extern RB mailboxes[MAX_MBX];
+extern U32 g_mbx_map[BM_WORDS(MAX_TASKS)];
+void init_rb (RB* rb, U32 size);
+int k_mbx_create    (size_t size);
+int k_send_msg      (task_t receiver_tid, const void *buf);
+int k_send_msg_nb   (task_t receiver_tid, const void *buf);
+int k_recv_msg      (void *buf, size_t len);
+int k_recv_msg_nb   (void *buf, size_t len);
+int k_mbx_ls        (task_t *buf, size_t count);
+int k_mbx_get       (task_t tid);
+void *k_msg_alloc   (size_t size);
+int k_msg_free      (void *msg);
+int k_msg_check     (void *msg, int shared_ok);
+void k_zc_put       (void *msg);
+ZC_BUF *k_zc_lookup (const void *msg);
+U32 k_zc_length     (const void *msg);
+void k_zc_release_task(task_t tid);
+int k_send_msg_zc   (task_t receiver_tid, void *msg);
+int k_recv_msg_zc   (void **p_msg);
+int k_mbx_alloc     (mbx_t mbx, size_t size);
+int k_mbx_create_ex (size_t size);
+int k_mbx_delete    (mbx_t mbx);
+void k_mbx_delete_all(void);
+RB *k_mbx_lookup    (mbx_t mbx);
+int k_mbx_send      (mbx_t mbx, const void *buf, U32 timeout);
+int k_mbx_recv      (mbx_t mbx, void *buf, size_t len, U32 timeout);
+int k_send_msg_mbx  (mbx_t mbx, const void *buf, U32 timeout);
+int k_recv_msg_mbx  (mbx_t mbx, void *buf, size_t len, U32 timeout);
+int k_send_msg_timeout(task_t receiver_tid, const void *buf, TIMEVAL *p_tv);
+int k_recv_msg_timeout(void *buf, size_t len, TIMEVAL *p_tv);
+U32 k_tv_to_ticks   (TIMEVAL *p_tv);
+int k_mbx_select    (mbx_t *handles, int n, TIMEVAL *p_tv);
+int k_mbx_set_mode  (mbx_t mbx, int mode);
+int k_send_msg_batch(task_t receiver_tid, const void *buf, int count);
+int k_recv_msg_batch(void *buf, size_t len, int max);
+int k_mbx_take_type (RB* rb, U32 type_mask, void *buf, size_t len);
+int k_recv_msg_type (U32 type_mask, void *buf, size_t len, TIMEVAL *p_tv);
+int k_mbx_peek_msg  (mbx_t mbx, RTX_MSG_HDR *hdr);
+int k_mbx_stat      (mbx_t mbx, MBX_STAT *buf);
+void k_mbx_count_in (RB* rb, U32 length);
+void k_mbx_count_out(RB* rb, U32 length);
+int k_msg_call      (task_t server, const void *req, void *reply_buf, size_t len);
+int k_msg_reply     (task_t client, const void *reply);
+void k_msg_call_abort(task_t server);
+int k_msg_level     (U8 prio);
+MSG_NODE *k_mbx_front(RB* rb);
+int k_mbx_put       (RB* rb, U32 length, const void *buf);
+int k_mbx_post      (RB* rb, const void *buf);
+void k_mbx_peek     (RB* rb, void *buf, U32 n);
+void k_mbx_pop      (RB* rb, void *buf);
+int k_mbx_read      (RB* rb, void *buf, size_t len);
+int k_mbx_wait      (RB* rb, U32 timeout);
+void k_mbx_wake_sender(RB* rb);
+void k_mbx_wake_receiver(RB* rb);
+int check_queue_empty(RB* rb);
+int check_rb_empty   (RB* rb);
+int get_rb_free_size (RB* rb);
+int k_mbx_space     (RB* rb);
+void k_mbx_wait_done(MBX_WAIT *p_wait, U32 since);
+TCB* get_waiting_highest(RB* rb);
+void k_mbx_drain    (RB* rb);
+U8  get_msg_type    (RB* rb);
+#ifdef MBX_BENCH
+void k_mbx_bench    (void);
+#endif
+int get_msg_size(RB* rb);
+int k_recv_uart(U8* buf, size_t len);
+int k_send_to_uart(const void* buf);
+#endif // ! K_MSG_H_
+
+/*
+ *===========================================================================
+ *                             END OF FILE
+ *===========================================================================
+ */
+
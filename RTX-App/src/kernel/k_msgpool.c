@@ -0,0 +1,285 @@
+/*
+ ****************************************************************************
+ *
+ *                  UNIVERSITY OF WATERLOO ECE 350 RTX LAB  
+ *
+ *                     Copyright 2020-2022 Yiqing Huang
+ *                          All rights reserved.
+ *---------------------------------------------------------------------------
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice and the following disclaimer.
+ *
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS AND CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *---------------------------------------------------------------------------*/
+ 
+
+/**************************************************************************//**
+ * @file        k_msgpool.c
+ * @brief       kernel fixed-size message buffer pools
+ *
+ * @details     All blocks of a pool are taken from IRAM2 in one piece when
+ *              the pool is created. Getting and putting a block is a free
+ *              list pop or push, no allocator call is left on the path of
+ *              a message. A task that finds the pool empty can wait for a
+ *              block, msgpool_put hands it straight to the most urgent
+ *              waiter. A bitmap behind the blocks tells which ones are
+ *              out, so a block put back twice is refused.
+ *****************************************************************************/
+
+#include "k_inc.h"
+#include "k_rtx.h"
+#include "k_task.h"
+#include "k_mem.h"
+#include "k_msg.h"
+#include "k_sync.h"
+#include "k_msgpool.h"
+
+MSGPOOL g_msgpools[MAX_MSGPOOLS];
+
+void k_msgpool_init(void)
+{
+    for (int i = 0; i < MAX_MSGPOOLS; i++) {
+        g_msgpools[i].used = 0;
+        q_init_list_head(&g_msgpools[i].wait);
+    }
+}
+
+/**************************************************************************//**
+ * @brief   look up a pool created by msgpool_create
+ * @return  the pool, NULL with errno EINVAL
+ *****************************************************************************/
+static MSGPOOL *k_msgpool_lookup(int pool)
+{
+    if (pool < 0 || pool >= MAX_MSGPOOLS || !g_msgpools[pool].used) {
+        errno = EINVAL;
+        return NULL;
+    }
+    return &g_msgpools[pool];
+}
+
+/* index of a block handed out by the pool */
+static int k_msgpool_index(MSGPOOL *p_pool, void *blk)
+{
+    return ((U8 *) blk - p_pool->mem) / p_pool->blk_size;
+}
+
+/* give the pool memory back to IRAM2 and free the slot */
+static void k_msgpool_free(MSGPOOL *p_pool)
+{
+    k_mpool_dealloc(MPID_IRAM2, p_pool->mem);
+    p_pool->mem = NULL;
+    p_pool->in_use = NULL;
+    p_pool->free = NULL;
+    p_pool->used = 0;
+}
+
+/**************************************************************************//**
+ * @brief       create a pool of num blocks of blk_size bytes each
+ * @return      pool ID on success; RTX_ERR on failure
+ * @note        blk_size is rounded up to a multiple of 4 bytes
+ *****************************************************************************/
+int k_msgpool_create(size_t blk_size, int num)
+{
+#ifdef DEBUG_0
+    printf("k_msgpool_create: blk_size = %u, num = %d\r\n", blk_size, num);
+#endif /* DEBUG_0 */
+    MSGPOOL *p_pool = NULL;
+    U8 *p_blk;
+    int pool;
+
+    if (blk_size < MIN_MSG_SIZE || num < 1 || num > 0xFFFF) {
+        errno = EINVAL;
+        return RTX_ERR;
+    }
+    for (pool = 0; pool < MAX_MSGPOOLS; pool++) {
+        if (!g_msgpools[pool].used) {
+            p_pool = &g_msgpools[pool];
+            break;
+        }
+    }
+    if (p_pool == NULL) {
+        errno = ENOMEM;
+        return RTX_ERR;
+    }
+    blk_size = (blk_size + 3) & ~3;
+    p_pool->mem = k_mpool_alloc(MPID_IRAM2, blk_size * num + BM_WORDS(num) * sizeof(U32));
+    if (p_pool->mem == NULL) {
+        errno = ENOMEM;
+        return RTX_ERR;
+    }
+    p_pool->in_use = (U32 *)(p_pool->mem + blk_size * num);
+    setmem(p_pool->in_use, 0, BM_WORDS(num) * sizeof(U32));
+    p_pool->blk_size = blk_size;
+    p_pool->num      = num;
+    p_pool->num_free = num;
+    p_pool->free     = NULL;
+    p_blk = p_pool->mem + blk_size * num;
+    for (int i = 0; i < num; i++) {         // thread the list front to back
+        p_blk -= blk_size;
+        *(void **) p_blk = p_pool->free;
+        p_pool->free = p_blk;
+    }
+    p_pool->owner = gp_current_task->tid;
+    p_pool->used = 1;
+    return pool;
+}
+
+/**************************************************************************//**
+ * @brief       take a block from a pool
+ * @return      the block on success; NULL on failure with errno ETIMEDOUT,
+ *              or ENOMEM for a {0, 0} timeout on an empty pool
+ * @param       p_tv    how long to wait for a block, NULL waits forever
+ *****************************************************************************/
+void *k_msgpool_get(int pool, TIMEVAL *p_tv)
+{
+#ifdef DEBUG_0
+    printf("k_msgpool_get: pool = %d, p_tv = 0x%x\r\n", pool, p_tv);
+#endif /* DEBUG_0 */
+    U32 timeout = k_tv_to_ticks(p_tv);
+    MSGPOOL *p_pool = k_msgpool_lookup(pool);
+    void *p_blk;
+
+    if (p_pool == NULL) {
+        return NULL;
+    }
+    p_blk = p_pool->free;
+    if (p_blk != NULL) {
+        p_pool->free = *(void **) p_blk;
+        p_pool->num_free--;
+        bm_set(p_pool->in_use, k_msgpool_index(p_pool, p_blk));
+        return p_blk;
+    }
+    if (timeout == 0) {
+        errno = ENOMEM;
+        return NULL;
+    }
+    gp_current_task->timed_out = 0;
+    if (timeout != TMO_FOREVER) {
+        k_tmo_arm(gp_current_task, timeout);
+    }
+    gp_current_task->mp_blk = NULL;
+    gp_current_task->blk_on = pool;
+    gp_current_task->state = BLK_MSGPOOL;
+    k_sync_enqueue(&p_pool->wait, gp_current_task);
+    k_tsk_run_new();
+    if (gp_current_task->timed_out) {
+        errno = ETIMEDOUT;
+        return NULL;
+    }
+    return gp_current_task->mp_blk;     // k_msgpool_put left the block here
+}
+
+/**************************************************************************//**
+ * @brief       give a block back to its pool
+ * @return      RTX_OK on success; RTX_ERR on failure with errno EFAULT if
+ *              blk is not a block of the pool, EINVAL if it is not out
+ * @note        a waiter gets the block directly, it stays marked as out
+ *****************************************************************************/
+int k_msgpool_put(int pool, void *blk)
+{
+#ifdef DEBUG_0
+    printf("k_msgpool_put: pool = %d, blk = 0x%x\r\n", pool, blk);
+#endif /* DEBUG_0 */
+    MSGPOOL *p_pool = k_msgpool_lookup(pool);
+    TCB *p_tcb;
+    U32 offset;
+
+    if (p_pool == NULL) {
+        return RTX_ERR;
+    }
+    offset = (U8 *) blk - p_pool->mem;
+    if (blk == NULL || offset >= p_pool->blk_size * p_pool->num || offset % p_pool->blk_size != 0) {
+        errno = EFAULT;             // not a block of this pool
+        return RTX_ERR;
+    }
+    if (!bm_test(p_pool->in_use, k_msgpool_index(p_pool, blk))) {
+        errno = EINVAL;             // already back in the pool
+        return RTX_ERR;
+    }
+    p_tcb = q_list_first_entry_or_null(&p_pool->wait);
+    if (p_tcb == NULL) {
+        bm_clr(p_pool->in_use, k_msgpool_index(p_pool, blk));
+        *(void **) blk = p_pool->free;
+        p_pool->free = blk;
+        p_pool->num_free++;
+        if (p_pool->owner == TID_UNK && p_pool->num_free == p_pool->num) {
+            k_msgpool_free(p_pool);     // the creator is gone, this was the last block out
+        }
+        return RTX_OK;
+    }
+    p_tcb->mp_blk = blk;
+    k_sync_wake(p_tcb);
+    k_sync_preempt(p_tcb);
+    return RTX_OK;
+}
+
+/**************************************************************************//**
+ * @brief       delete a pool and give its memory back to IRAM2
+ * @return      RTX_OK on success; RTX_ERR on failure with errno EPERM if
+ *              the caller did not create the pool, EAGAIN while a block
+ *              is still out
+ * @note        with every block back there is no waiter to care about
+ *****************************************************************************/
+int k_msgpool_delete(int pool)
+{
+#ifdef DEBUG_0
+    printf("k_msgpool_delete: pool = %d\r\n", pool);
+#endif /* DEBUG_0 */
+    MSGPOOL *p_pool = k_msgpool_lookup(pool);
+
+    if (p_pool == NULL) {
+        return RTX_ERR;
+    }
+    if (p_pool->owner != gp_current_task->tid) {
+        errno = EPERM;
+        return RTX_ERR;
+    }
+    if (p_pool->num_free != p_pool->num) {
+        errno = EAGAIN;
+        return RTX_ERR;
+    }
+    k_msgpool_free(p_pool);
+    return RTX_OK;
+}
+
+/**************************************************************************//**
+ * @brief   let go of the pools an exiting task created, used on exit
+ * @note    a pool with every block back is freed, one with blocks still
+ *          out stays for their holders and has no owner from then on, so
+ *          a later task with the same TID cannot delete it. The last
+ *          msgpool_put then frees it.
+ *****************************************************************************/
+void k_msgpool_release_task(task_t tid)
+{
+    for (int i = 0; i < MAX_MSGPOOLS; i++) {
+        MSGPOOL *p_pool = &g_msgpools[i];
+
+        if (!p_pool->used || p_pool->owner != tid) {
+            continue;
+        }
+        if (p_pool->num_free == p_pool->num) {
+            k_msgpool_free(p_pool);
+        } else {
+            p_pool->owner = TID_UNK;
+        }
+    }
+}
+
+/*
+ *===========================================================================
+ *                             END OF FILE
+ *===========================================================================
+ */
@@ -0,0 +1,86 @@
+/*
+ ****************************************************************************
+ *
+ *                  UNIVERSITY OF WATERLOO ECE 350 RTX LAB  
+ *
+ *                     Copyright 2020-2022 Yiqing Huang
+ *                          All rights reserved.
+ *---------------------------------------------------------------------------
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice and the following disclaimer.
+ *
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS AND CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *---------------------------------------------------------------------------*/
+ 
+
+/**************************************************************************//**
+ * @file        k_msgpool.h
+ * @brief       kernel fixed-size message buffer pools header file
+ *****************************************************************************/
+
+#ifndef K_MSGPOOL_H_
+#define K_MSGPOOL_H_
+
+#include "k_inc.h"
+
+/*
+ *===========================================================================
+ *                             STRUCTURES
+ *===========================================================================
+ */
+
+/* a free block holds the link to the next free block in its first word */
+typedef struct k_msgpool {
+    U8         *mem;            /**< num blocks of blk_size bytes       */
+    U32        *in_use;         /**< bit i set while block i is out     */
+    void       *free;           /**< free list, NULL when exhausted     */
+    U32         blk_size;       /**< block size, a multiple of 4        */
+    U16         num;            /**< number of blocks                   */
+    U16         num_free;       /**< blocks on the free list            */
+    U8          used;           /**< slot taken by msgpool_create       */
+    task_t      owner;          /**< creator, the only one to delete it,
+                                     TID_UNK once it exited             */
+    TCB         wait;           /**< BLK_MSGPOOL waiters, list head     */
+} MSGPOOL;
+
+/*
+ *===========================================================================
+ *                            GLOBAL VARIABLES
+ *===========================================================================
+ */
+
+extern MSGPOOL g_msgpools[MAX_MSGPOOLS];
+
+/*
+ *===========================================================================
+ *                            FUNCTION PROTOTYPES
+ *===========================================================================
+ */
+
+void k_msgpool_init     (void);
+int  k_msgpool_create   (size_t blk_size, int num);
+void *k_msgpool_get     (int pool, TIMEVAL *p_tv);
+int  k_msgpool_put      (int pool, void *blk);
+int  k_msgpool_delete   (int pool);
+void k_msgpool_release_task(task_t tid);
+
+#endif // ! K_MSGPOOL_H_
+
+/*
+ *===========================================================================
+ *                             END OF FILE
+ *===========================================================================
+ */
@@ -0,0 +1,235 @@
+/*
+ ****************************************************************************
+ *
+ *                  UNIVERSITY OF WATERLOO ECE 350 RTX LAB  
+ *
+ *                     Copyright 2020-2022 Yiqing Huang
+ *                          All rights reserved.
+ *---------------------------------------------------------------------------
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice and the following disclaimer.
+ *
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS AND CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *---------------------------------------------------------------------------*/
+ 
+
+/**************************************************************************//**
+ * @file        k_pool.c
+ * @brief       kernel worker pool routines
+ *
+ * @details     Creating a task allocates a user stack and fabricates its
+ *              initial context, exiting frees it again. A worker pool pays
+ *              that cost once: the workers loop in task_pool_worker, taking
+ *              jobs from the pool queue and blocking in BLK_POOL when the
+ *              queue is empty.
+ *****************************************************************************/
+
+#include "k_inc.h"
+#include "k_rtx.h"
+#include "k_task.h"
+#include "k_pool.h"
+
+POOL g_pools[MAX_POOLS];
+
+void k_pool_init(void)
+{
+    for (int i = 0; i < MAX_POOLS; i++) {
+        g_pools[i].head        = 0;
+        g_pools[i].count       = 0;
+        g_pools[i].num_workers = 0;
+        q_init_list_head(&g_pools[i].idle);
+    }
+}
+
+/**************************************************************************//**
+ * @brief       create a pool of worker tasks
+ * @return      pool ID on success; RTX_ERR on failure
+ * @param       num_workers number of worker tasks to start
+ * @param       prio        priority of the workers, HIGH to LOWEST
+ * @param       stack_size  user stack size of each worker
+ * @note        fewer workers are started if TIDs or memory run out half
+ *              way, the call only fails if none of them could be created
+ *****************************************************************************/
+int k_tsk_pool_create(U8 num_workers, U8 prio, U32 stack_size)
+{
+#ifdef DEBUG_0
+    printf("k_tsk_pool_create: num_workers = %d, prio = %d, stack_size = %d\r\n", num_workers, prio, stack_size);
+#endif /* DEBUG_0 */
+    int pool_id;
+    POOL *p_pool;
+    TASK_INIT taskinfo;
+
+    if (prio != HIGH && prio != MEDIUM && prio != LOW && prio != LOWEST) {
+        errno = EINVAL;
+        return RTX_ERR;
+    }
+    if (num_workers == 0) {
+        errno = EINVAL;
+        return RTX_ERR;
+    }
+    for (pool_id = 0; pool_id < MAX_POOLS; pool_id++) {
+        if (g_pools[pool_id].num_workers == 0) {
+            break;
+        }
+    }
+    if (pool_id == MAX_POOLS) {
+        errno = EAGAIN;
+        return RTX_ERR;
+    }
+
+    p_pool = &g_pools[pool_id];
+    p_pool->head = 0;
+    p_pool->count = 0;
+    p_pool->prio = prio;
+    q_init_list_head(&p_pool->idle);
+
+    taskinfo.ptask = (void (*)(void)) &task_pool_worker;  // pool_id goes in through R0 below
+    taskinfo.prio  = prio;
+    taskinfo.priv  = 0;
+    for (int i = 0; i < num_workers; i++) {
+        int tid = get_valid_tid();
+        if (tid == RTX_ERR) {
+            errno = EAGAIN;
+            break;
+        }
+        taskinfo.u_stack_size = stack_size;
+        if (k_tsk_create_new(&taskinfo, &g_tcbs[tid], tid) != RTX_OK) {
+            bm_clr(g_tid_map, tid);
+            errno = ENOMEM;
+            break;
+        }
+        // the worker finds its pool ID in R0 of the fabricated user frame
+        *((U32 *) g_tcbs[tid].u_sp) = pool_id;
+        g_tcbs[tid].pool = pool_id;
+        q_add_to_list_last(&g_tcbs[tid], &queue[prio - HIGH], queue[prio - HIGH].prev);
+        p_pool->num_workers++;
+        g_num_active_tasks++;
+    }
+    if (p_pool->num_workers == 0) {
+        return RTX_ERR;
+    }
+    if (!gp_current_task->rt_flag && prio < gp_current_task->prio) {
+        q_add_to_list_head(gp_current_task, &queue[gp_current_task->prio - HIGH], queue[gp_current_task->prio - HIGH].next);
+        k_tsk_run_new();
+    }
+    return pool_id;
+}
+
+/**************************************************************************//**
+ * @brief       queue a job to a worker pool
+ * @return      RTX_OK on success; RTX_ERR on failure
+ * @param       pool_id     the pool returned by k_tsk_pool_create
+ * @param       func        job entry, called as func(arg) by a worker
+ * @param       arg         job argument
+ * @note        never blocks, fails with EAGAIN when the job queue is full.
+ *              An idle worker is woken and preempts a lower priority caller.
+ *****************************************************************************/
+int k_tsk_pool_submit(int pool_id, void (*func)(void *), void *arg)
+{
+    POOL *p_pool;
+    TCB  *p_worker;
+
+    if (pool_id < 0 || pool_id >= MAX_POOLS || g_pools[pool_id].num_workers == 0) {
+        errno = EINVAL;
+        return RTX_ERR;
+    }
+    if (func == NULL) {
+        errno = EFAULT;
+        return RTX_ERR;
+    }
+    p_pool = &g_pools[pool_id];
+    if (p_pool->count == POOL_MAX_JOBS) {
+        errno = EAGAIN;
+        return RTX_ERR;
+    }
+
+    POOL_JOB *p_job = &p_pool->jobs[(p_pool->head + p_pool->count) % POOL_MAX_JOBS];
+    p_job->func = func;
+    p_job->arg  = arg;
+    p_pool->count++;
+
+    p_worker = q_delete_first_node(&p_pool->idle);
+    if (p_worker != NULL) {
+        // the worker's own priority, tsk_set_prio may have changed it
+        p_worker->state = READY;
+        q_add_to_list_last(p_worker, &queue[p_worker->prio - HIGH], queue[p_worker->prio - HIGH].prev);
+        k_sync_preempt(p_worker);
+    }
+    return RTX_OK;
+}
+
+/**************************************************************************//**
+ * @brief       take the oldest job of the pool, block while there is none
+ * @return      RTX_OK on success; RTX_ERR on failure
+ * @param       pool_id     the pool the calling worker belongs to
+ * @param       job         output buffer for the job
+ * @note        only the workers of the pool may call it
+ *****************************************************************************/
+int k_tsk_pool_take(int pool_id, POOL_JOB *job)
+{
+    POOL *p_pool;
+
+    if (pool_id < 0 || pool_id >= MAX_POOLS || gp_current_task->pool != pool_id) {
+        errno = EPERM;
+        return RTX_ERR;
+    }
+    if (job == NULL) {
+        errno = EFAULT;
+        return RTX_ERR;
+    }
+    p_pool = &g_pools[pool_id];
+
+    // another worker may take the job between our wake-up and our run
+    while (p_pool->count == 0) {
+        gp_current_task->state = BLK_POOL;
+        q_add_to_list_last(gp_current_task, &p_pool->idle, p_pool->idle.prev);
+        k_tsk_run_new();
+    }
+
+    *job = p_pool->jobs[p_pool->head];
+    p_pool->head = (p_pool->head + 1) % POOL_MAX_JOBS;
+    p_pool->count--;
+    return RTX_OK;
+}
+
+/**************************************************************************//**
+ * @brief   take an exiting worker off its pool, used on exit
+ * @note    a pool whose last worker is gone drops its queued jobs and
+ *          its slot is free again, submit fails with EINVAL from then on
+ *****************************************************************************/
+void k_tsk_pool_release_task(task_t tid)
+{
+    TCB *p_tcb = &g_tcbs[tid];
+    POOL *p_pool;
+
+    if (p_tcb->pool < 0) {
+        return;
+    }
+    p_pool = &g_pools[p_tcb->pool];
+    p_pool->num_workers--;
+    if (p_pool->num_workers == 0) {
+        p_pool->head = 0;
+        p_pool->count = 0;
+    }
+    p_tcb->pool = -1;
+}
+
+/*
+ *===========================================================================
+ *                             END OF FILE
+ *===========================================================================
+ */
+
@@ -0,0 +1,76 @@
+/*
+ ****************************************************************************
+ *
+ *                  UNIVERSITY OF WATERLOO ECE 350 RTX LAB  
+ *
+ *                     Copyright 2020-2022 Yiqing Huang
+ *                          All rights reserved.
+ *---------------------------------------------------------------------------
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice and the following disclaimer.
+ *
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS AND CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *---------------------------------------------------------------------------*/
+ 
+
+/**************************************************************************//**
+ * @file        k_pool.h
+ * @brief       kernel worker pool header file
+ *
+ * @note        workers are ordinary tasks created once by k_tsk_pool_create
+ *              and then fed with jobs through a bounded per-pool queue
+ *****************************************************************************/
+
+#ifndef K_POOL_H_
+#define K_POOL_H_
+
+#include "k_inc.h"
+
+/*
+ *===========================================================================
+ *                             STRUCTURES
+ *===========================================================================
+ */
+
+typedef struct k_pool {
+    POOL_JOB    jobs[POOL_MAX_JOBS];    /**< circular job queue               */
+    U8          head;                   /**< index of the oldest queued job   */
+    U8          count;                  /**< number of queued jobs            */
+    U8          num_workers;            /**< 0 if the pool slot is free       */
+    U8          prio;                   /**< priority of all pool workers     */
+    TCB         idle;                   /**< workers blocked in BLK_POOL      */
+} POOL;
+
+/*
+ *===========================================================================
+ *                            FUNCTION PROTOTYPES
+ *===========================================================================
+ */
+
+void k_pool_init            (void);
+int  k_tsk_pool_create      (U8 num_workers, U8 prio, U32 stack_size);
+int  k_tsk_pool_submit      (int pool_id, void (*func)(void *), void *arg);
+int  k_tsk_pool_take        (int pool_id, POOL_JOB *job);
+void k_tsk_pool_release_task(task_t tid);
+
+#endif // ! K_POOL_H_
+
+/*
+ *===========================================================================
+ *                             END OF FILE
+ *===========================================================================
+ */
+
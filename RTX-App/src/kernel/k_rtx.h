@@ -1,54 +1,60 @@
-/*
- ****************************************************************************
- *
- *                  UNIVERSITY OF WATERLOO ECE 350 RTOS LAB
- *
- *                     Copyright 2020-2022 Yiqing Huang
- *                          All rights reserved.
- *
- *  Redistribution and use in source and binary forms, with or without
- *  modification, are permitted provided that the following conditions are met:
- *  - Redistributions of source code must retain the above copyright
- *    notice and the following disclaimer.
- *
- *
- *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
- *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
- *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
- *  ARE DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS AND CONTRIBUTORS BE
- *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
- *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
- *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
- *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
- *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
- *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
- *  POSSIBILITY OF SUCH DAMAGE.
- ****************************************************************************
- */
-
-/**************************************************************************//**
- * @file        k_rtx.h
- * @brief       Kernel API Header File
- * @version     V1.2021.04.lab1
- * @authors     Yiqing Huang
- * @date        2021 APR 
- *
- * @note        all kernel .c files include this one
- *
- *****************************************************************************/
-
-#ifndef K_RTX_H_
-#define K_RTX_H_
-
-#include "k_rtx_init.h"     // lab1
-#include "k_mem.h"          // lab1
-#include "k_task.h"         // lab2
-#include "k_msg.h"          // lab3
-#include "uart_irq.h"       // lab3
-#include "timer.h"          // lab4
-#endif // ! K_RTX_H_ 
-/*
- *===========================================================================
- *                             END OF FILE
- *===========================================================================
- */
+/*
+ ****************************************************************************
+ *
+ *                  UNIVERSITY OF WATERLOO ECE 350 RTOS LAB
+ *
+ *                     Copyright 2020-2022 Yiqing Huang
+ *                          All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice and the following disclaimer.
+ *
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS AND CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ ****************************************************************************
+ */
+
+/**************************************************************************//**
+ * @file        k_rtx.h
+ * @brief       Kernel API Header File
+ * @version     V1.2021.04.lab1
+ * @authors     Yiqing Huang
+ * @date        2021 APR 
+ *
+ * @note        all kernel .c files include this one
+ *
+ *****************************************************************************/
+
+#ifndef K_RTX_H_
+#define K_RTX_H_
+
+#include "k_rtx_init.h"     // lab1
+#include "k_mem.h"          // lab1
+#include "k_task.h"         // lab2
+#include "k_msg.h"          // lab3
+#include "uart_irq.h"       // lab3
+#include "timer.h"          // lab4
+#include "k_pool.h"         // worker pool
+#include "k_topic.h"        // publish/subscribe
+#include "k_spsc.h"         // ISR to task byte rings
+#include "k_sync.h"         // semaphores and mutexes
+#include "k_msgpool.h"      // fixed-size message buffers
+#include "k_chan.h"         // shared-memory producer/consumer channels
+#endif // ! K_RTX_H_ 
+/*
+ *===========================================================================
+ *                             END OF FILE
+ *===========================================================================
+ */
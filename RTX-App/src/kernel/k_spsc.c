@@ -0,0 +1,217 @@
+/*
+ ****************************************************************************
+ *
+ *                  UNIVERSITY OF WATERLOO ECE 350 RTX LAB  
+ *
+ *                     Copyright 2020-2022 Yiqing Huang
+ *                          All rights reserved.
+ *---------------------------------------------------------------------------
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice and the following disclaimer.
+ *
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS AND CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *---------------------------------------------------------------------------*/
+ 
+
+/**************************************************************************//**
+ * @file        k_spsc.c
+ * @brief       single producer single consumer byte ring
+ *
+ * @details     An ISR pushes bytes without allocating and without touching
+ *              any kernel list, only the consumer wakeup does. Each index
+ *              is written by one side only, so the ring needs no lock and
+ *              no interrupt masking. The byte is stored before head moves,
+ *              the consumer never sees a slot that is not filled yet.
+ *****************************************************************************/
+
+#include "k_inc.h"
+#include "k_rtx.h"
+#include "k_task.h"
+#include "k_spsc.h"
+
+SPSC g_uart_rx;
+
+void k_spsc_init(SPSC *q)
+{
+    q->head    = 0;
+    q->tail    = 0;
+    q->waiter  = NULL;
+    q->consumer = TID_UNK;
+    q->dropped = 0;
+}
+
+/**************************************************************************//**
+ * @brief       make the calling task the consumer of the ring
+ * @return      RTX_OK if it is or just became the consumer; RTX_ERR with
+ *              errno EPERM if another task is
+ * @note        the first task to pop claims the ring until it exits
+ *****************************************************************************/
+int k_spsc_claim(SPSC *q)
+{
+    if (q->consumer == TID_UNK) {
+        q->consumer = gp_current_task->tid;
+    }
+    if (q->consumer != gp_current_task->tid) {
+        errno = EPERM;
+        return RTX_ERR;
+    }
+    return RTX_OK;
+}
+
+/**************************************************************************//**
+ * @brief       push one byte, called by the producer ISR
+ * @return      RTX_OK on success; RTX_ERR if the ring is full
+ * @note        a consumer blocked on the ring is made ready, it runs at
+ *              the next scheduling point
+ *****************************************************************************/
+int k_spsc_put(SPSC *q, U8 c)
+{
+    U32 head = q->head;
+    TCB *p_tcb;
+
+    if (head - q->tail == SPSC_SIZE) {
+        q->dropped++;
+        return RTX_ERR;
+    }
+    q->buf[head & (SPSC_SIZE - 1)] = c;
+    q->head = head + 1;
+
+    p_tcb = q->waiter;
+    if (p_tcb != NULL && p_tcb->state == BLK_RECV) {
+        q->waiter = NULL;
+        p_tcb->state = READY;
+        q_add_to_list_last(p_tcb, &queue[p_tcb->prio - HIGH], queue[p_tcb->prio - HIGH].prev);
+    }
+    return RTX_OK;
+}
+
+/**************************************************************************//**
+ * @brief       pop one byte, blocking the calling task while the ring is empty
+ * @return      the byte on success; RTX_ERR on failure
+ * @param       timeout ticks to wait, 0 fails with ENOMSG right away,
+ *                      TMO_FOREVER waits until a byte arrives
+ *****************************************************************************/
+int k_spsc_get(SPSC *q, U32 timeout)
+{
+    U32 tail = q->tail;
+    U8  c;
+
+    gp_current_task->timed_out = 0;
+    while (q->head == tail) {
+        if (timeout == 0) {
+            errno = ENOMSG;
+            return RTX_ERR;
+        }
+        if (gp_current_task->timed_out) {
+            errno = ETIMEDOUT;
+            return RTX_ERR;
+        }
+        if (timeout != TMO_FOREVER) {
+            k_tmo_arm(gp_current_task, timeout);
+        }
+        q->waiter = gp_current_task;
+        gp_current_task->state = BLK_RECV;
+        k_tsk_run_new();
+        if (q->waiter == gp_current_task) {
+            q->waiter = NULL;               // woken by the timer, not by the ISR
+        }
+    }
+    k_tmo_cancel(gp_current_task);
+    c = q->buf[tail & (SPSC_SIZE - 1)];
+    q->tail = tail + 1;
+    return c;
+}
+
+/**************************************************************************//**
+ * @brief       take the next character typed on UART0
+ * @return      the character on success; RTX_ERR on failure
+ * @note        only one task may read, the ring has a single consumer.
+ *              The first caller becomes it, any other gets EPERM.
+ *****************************************************************************/
+int k_uart_getc(void)
+{
+#ifdef DEBUG_0
+    printf("k_uart_getc: entering...\r\n");
+#endif /* DEBUG_0 */
+    if (k_spsc_claim(&g_uart_rx) != RTX_OK) {
+        return RTX_ERR;
+    }
+    return k_spsc_get(&g_uart_rx, TMO_FOREVER);
+}
+
+/**************************************************************************//**
+ * @brief       wait until a mailbox holds a message or a character was
+ *              typed on UART0
+ * @return      0 for the mailbox, 1 for UART0, RTX_ERR on failure
+ * @param       mbx     a mailbox of the calling task
+ * @details     The task waits as the receiver of the mailbox and the
+ *              consumer of the UART0 ring at once, whichever gets data
+ *              first wakes it. The mailbox is looked at first. Nothing is
+ *              taken, follow up with recv_msg_mbx or uart_getc, which then
+ *              does not block.
+ *****************************************************************************/
+int k_uart_select(mbx_t mbx)
+{
+#ifdef DEBUG_0
+    printf("k_uart_select: mbx = %d\r\n", mbx);
+#endif /* DEBUG_0 */
+    RB *p_mbx = k_mbx_lookup(mbx);
+
+    if (p_mbx == NULL) {
+        return RTX_ERR;
+    }
+    if (p_mbx->owner != gp_current_task->tid) {
+        errno = EPERM;
+        return RTX_ERR;
+    }
+    if (k_spsc_claim(&g_uart_rx) != RTX_OK) {
+        return RTX_ERR;
+    }
+    while (1) {
+        if (!check_rb_empty(p_mbx)) {
+            return 0;
+        }
+        if (g_uart_rx.head != g_uart_rx.tail) {
+            return 1;
+        }
+        p_mbx->receiver = gp_current_task;
+        g_uart_rx.waiter = gp_current_task;
+        gp_current_task->state = BLK_RECV;
+        gp_current_task->blk_since = g_timer_count;
+        k_tsk_run_new();
+        k_mbx_wait_done(&p_mbx->recv_wait, gp_current_task->blk_since);
+        if (p_mbx->receiver == gp_current_task) {
+            p_mbx->receiver = NULL;         // woken by the ISR
+        }
+        if (g_uart_rx.waiter == gp_current_task) {
+            g_uart_rx.waiter = NULL;        // woken by a sender
+        }
+    }
+}
+
+/* give up the UART0 ring, used on exit */
+void k_uart_release(task_t tid)
+{
+    if (g_uart_rx.consumer == tid) {
+        g_uart_rx.consumer = TID_UNK;
+    }
+}
+
+/*
+ *===========================================================================
+ *                             END OF FILE
+ *===========================================================================
+ */
@@ -0,0 +1,97 @@
+/*
+ ****************************************************************************
+ *
+ *                  UNIVERSITY OF WATERLOO ECE 350 RTX LAB  
+ *
+ *                     Copyright 2020-2022 Yiqing Huang
+ *                          All rights reserved.
+ *---------------------------------------------------------------------------
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice and the following disclaimer.
+ *
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS AND CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *---------------------------------------------------------------------------*/
+ 
+
+/**************************************************************************//**
+ * @file        k_spsc.h
+ * @brief       single producer single consumer byte ring header file
+ *
+ * @note        the producer is an ISR, the consumer a task through an SVC
+ *****************************************************************************/
+
+#ifndef K_SPSC_H_
+#define K_SPSC_H_
+
+#include "k_inc.h"
+
+/*
+ *===========================================================================
+ *                             MACROS
+ *===========================================================================
+ */
+
+#define SPSC_SIZE       64      /* bytes per ring, must be a power of two */
+
+#if (SPSC_SIZE & (SPSC_SIZE - 1)) != 0
+#error "SPSC_SIZE must be a power of two"
+#endif
+
+/*
+ *===========================================================================
+ *                             STRUCTURES
+ *===========================================================================
+ */
+
+/* head and tail run freely and wrap at 2^32, head - tail is the fill level */
+typedef struct k_spsc {
+    volatile U32    head;           /**< next slot to write, producer only  */
+    volatile U32    tail;           /**< next slot to read, consumer only   */
+    TCB            *waiter;         /**< consumer blocked on an empty ring  */
+    task_t          consumer;       /**< only task to pop, TID_UNK if none  */
+    U32             dropped;        /**< bytes lost to a full ring          */
+    U8              buf[SPSC_SIZE];
+} SPSC;
+
+/*
+ *===========================================================================
+ *                            GLOBAL VARIABLES
+ *===========================================================================
+ */
+
+extern SPSC g_uart_rx;          // UART0 receive data, filled by UART0_IRQHandler
+
+/*
+ *===========================================================================
+ *                            FUNCTION PROTOTYPES
+ *===========================================================================
+ */
+
+void k_spsc_init    (SPSC *q);
+int  k_spsc_put     (SPSC *q, U8 c);
+int  k_spsc_get     (SPSC *q, U32 timeout);
+int  k_spsc_claim   (SPSC *q);
+int  k_uart_getc    (void);
+int  k_uart_select  (mbx_t mbx);
+void k_uart_release (task_t tid);
+
+#endif // ! K_SPSC_H_
+
+/*
+ *===========================================================================
+ *                             END OF FILE
+ *===========================================================================
+ */
@@ -0,0 +1,662 @@
+/*
+ ****************************************************************************
+ *
+ *                  UNIVERSITY OF WATERLOO ECE 350 RTX LAB  
+ *
+ *                     Copyright 2020-2022 Yiqing Huang
+ *                          All rights reserved.
+ *---------------------------------------------------------------------------
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice and the following disclaimer.
+ *
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS AND CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *---------------------------------------------------------------------------*/
+ 
+
+/**************************************************************************//**
+ * @file        k_sync.c
+ * @brief       kernel semaphores, mutexes, futexes and event groups
+ *
+ * @details     Blocked tasks sit in the wait list of the object, linked
+ *              through the TCB prev/next fields like the ready queues.
+ *              sem_post and mutex_unlock hand the unit or the lock straight
+ *              to the first waiter, so a woken task never has to retry.
+ *
+ *              A mutex owner inherits the priority of its most urgent
+ *              waiter, along the chain of owners blocked on other mutexes.
+ *              Unlocking drops the owner back to the highest priority still
+ *              owed to it. Real-time tasks keep their own scheduling and do
+ *              not take part in inheritance.
+ *****************************************************************************/
+
+#include "k_inc.h"
+#include "k_rtx.h"
+#include "k_task.h"
+#include "k_msg.h"
+#include "k_sync.h"
+
+SEM   g_sems[MAX_SEMS];
+MUTEX g_mutexes[MAX_MUTEXES];
+TCB   g_futex_wait[FUTEX_HASH];     // BLK_FUTEX waiters, hashed by futex address
+EVT_GROUP g_evts[MAX_EVT_GROUPS];
+
+void k_sync_init(void)
+{
+    for (int i = 0; i < MAX_SEMS; i++) {
+        g_sems[i].used = 0;
+        q_init_list_head(&g_sems[i].wait);
+    }
+    for (int i = 0; i < MAX_MUTEXES; i++) {
+        g_mutexes[i].used  = 0;
+        g_mutexes[i].owner = NULL;
+        q_init_list_head(&g_mutexes[i].wait);
+    }
+    for (int i = 0; i < FUTEX_HASH; i++) {
+        q_init_list_head(&g_futex_wait[i]);
+    }
+    for (int i = 0; i < MAX_EVT_GROUPS; i++) {
+        g_evts[i].used = 0;
+        q_init_list_head(&g_evts[i].wait);
+    }
+}
+
+/**************************************************************************//**
+ * @brief   insert p_tcb into a wait list behind all tasks of equal or
+ *          higher priority
+ *****************************************************************************/
+void k_sync_enqueue(TCB *head, TCB *p_tcb)
+{
+    TCB *p_pos = head->next;
+
+    while (p_pos != head && p_pos->prio <= p_tcb->prio) {
+        p_pos = p_pos->next;
+    }
+    q_add_to_list_head(p_tcb, p_pos->prev, p_pos);
+}
+
+/**************************************************************************//**
+ * @brief   make a task ready again after it got what it was waiting for
+ *****************************************************************************/
+void k_sync_wake(TCB *p_tcb)
+{
+    q_delete_node(p_tcb);
+    k_tmo_cancel(p_tcb);
+    p_tcb->state = READY;
+    q_add_to_list_last(p_tcb, &queue[p_tcb->prio - HIGH], queue[p_tcb->prio - HIGH].prev);
+}
+
+/**************************************************************************//**
+ * @brief   let the running task give way to a woken task of higher priority
+ *****************************************************************************/
+void k_sync_preempt(TCB *p_tcb)
+{
+    if (!gp_current_task->rt_flag && p_tcb->prio < gp_current_task->prio) {
+        q_add_to_list_head(gp_current_task, &queue[gp_current_task->prio - HIGH], queue[gp_current_task->prio - HIGH].next);
+        k_tsk_run_new();
+    }
+}
+
+/**************************************************************************//**
+ * @brief   wait list of a futex word, picked by address
+ *****************************************************************************/
+static TCB *k_futex_bucket(volatile U32 *addr)
+{
+    return &g_futex_wait[((U32) addr >> 2) & (FUTEX_HASH - 1)];
+}
+
+/**************************************************************************//**
+ * @brief   change the effective priority of a task wherever it is queued
+ * @return  the mutex the task is blocked on, NULL if it is not
+ *****************************************************************************/
+static MUTEX *k_sync_set_prio(TCB *p_tcb, U8 prio)
+{
+    MUTEX *p_blk = NULL;
+
+    switch (p_tcb->state) {
+        case READY:
+            q_delete_node(p_tcb);
+            p_tcb->prio = prio;
+            q_add_to_list_last(p_tcb, &queue[prio - HIGH], queue[prio - HIGH].prev);
+            break;
+        case BLK_SEM:
+            q_delete_node(p_tcb);
+            p_tcb->prio = prio;
+            k_sync_enqueue(&g_sems[p_tcb->blk_on].wait, p_tcb);
+            break;
+        case BLK_MUTEX:
+            p_blk = &g_mutexes[p_tcb->blk_on];
+            q_delete_node(p_tcb);
+            p_tcb->prio = prio;
+            k_sync_enqueue(&p_blk->wait, p_tcb);
+            break;
+        case BLK_FUTEX:
+            q_delete_node(p_tcb);
+            p_tcb->prio = prio;
+            k_sync_enqueue(k_futex_bucket(p_tcb->futex), p_tcb);
+            break;
+        case BLK_EVENT:
+            q_delete_node(p_tcb);
+            p_tcb->prio = prio;
+            k_sync_enqueue(&g_evts[p_tcb->blk_on].wait, p_tcb);
+            break;
+        case BLK_MSGPOOL:
+            q_delete_node(p_tcb);
+            p_tcb->prio = prio;
+            k_sync_enqueue(&g_msgpools[p_tcb->blk_on].wait, p_tcb);
+            break;
+        case BLK_CHAN:
+            q_delete_node(p_tcb);
+            p_tcb->prio = prio;
+            k_sync_enqueue(&g_chans[p_tcb->blk_on].wait, p_tcb);
+            break;
+        default:
+            p_tcb->prio = prio;     // running, or queued where order does not follow prio
+            break;
+    }
+    return p_blk;
+}
+
+/**************************************************************************//**
+ * @brief   raise the owners along a chain of mutexes to prio
+ *****************************************************************************/
+static void k_mutex_inherit(MUTEX *p_mutex, U8 prio)
+{
+    while (p_mutex != NULL) {
+        TCB *p_owner = p_mutex->owner;
+        if (p_owner == NULL || p_owner->rt_flag || p_owner->prio <= prio) {
+            break;
+        }
+        p_mutex = k_sync_set_prio(p_owner, prio);
+    }
+}
+
+/**************************************************************************//**
+ * @brief   own priority of a task or that of the most urgent waiter of a
+ *          mutex it holds, whichever is higher
+ *****************************************************************************/
+static U8 k_mutex_prio(TCB *p_tcb)
+{
+    U8 prio = p_tcb->base_prio;
+
+    for (int i = 0; i < MAX_MUTEXES; i++) {
+        TCB *p_first = q_list_first_entry_or_null(&g_mutexes[i].wait);
+        if (g_mutexes[i].owner == p_tcb && p_first != NULL && p_first->prio < prio) {
+            prio = p_first->prio;
+        }
+    }
+    return prio;
+}
+
+/**************************************************************************//**
+ * @brief   drop a task to its own priority or the most urgent waiter of a
+ *          mutex it still holds, whichever is higher
+ *****************************************************************************/
+static void k_mutex_restore(TCB *p_tcb)
+{
+    U8 prio = k_mutex_prio(p_tcb);
+
+    if (p_tcb->rt_flag) {
+        return;
+    }
+    if (prio != p_tcb->prio) {
+        k_sync_set_prio(p_tcb, prio);
+    }
+}
+
+/**************************************************************************//**
+ * @brief   give a task a new own priority, keeping what it inherits
+ * @details A blocked task is re-sorted in its wait list. A waiter that
+ *          got more urgent passes that on along the mutex owner chain.
+ *****************************************************************************/
+void k_sync_set_base_prio(TCB *p_tcb, U8 prio)
+{
+    MUTEX *p_blk;
+
+    p_tcb->base_prio = prio;
+    if (!p_tcb->rt_flag) {
+        prio = k_mutex_prio(p_tcb);
+    }
+    if (prio == p_tcb->prio) {
+        return;
+    }
+    p_blk = k_sync_set_prio(p_tcb, prio);
+    if (p_blk != NULL) {
+        k_mutex_inherit(p_blk, prio);
+    }
+}
+
+/**************************************************************************//**
+ * @brief   pass a mutex on to its first waiter, or unlock it
+ * @return  the new owner, NULL if nobody was waiting
+ *****************************************************************************/
+static TCB *k_mutex_handoff(MUTEX *p_mutex)
+{
+    TCB *p_next = q_list_first_entry_or_null(&p_mutex->wait);
+
+    p_mutex->owner = p_next;
+    if (p_next != NULL) {
+        k_sync_wake(p_next);
+        k_mutex_restore(p_next);    // inherit from the waiters left behind it
+    }
+    return p_next;
+}
+
+/**************************************************************************//**
+ * @brief       create a counting semaphore
+ * @return      semaphore ID on success; RTX_ERR on failure
+ * @param       count   initial number of units, >= 0
+ *****************************************************************************/
+int k_sem_create(int count)
+{
+#ifdef DEBUG_0
+    printf("k_sem_create: count = %d\r\n", count);
+#endif /* DEBUG_0 */
+    if (count < 0) {
+        errno = EINVAL;
+        return RTX_ERR;
+    }
+    for (int i = 0; i < MAX_SEMS; i++) {
+        if (!g_sems[i].used) {
+            g_sems[i].used  = 1;
+            g_sems[i].count = count;
+            return i;
+        }
+    }
+    errno = ENOMEM;
+    return RTX_ERR;
+}
+
+/**************************************************************************//**
+ * @brief       take one unit of a semaphore, blocking while there is none
+ * @return      RTX_OK on success; RTX_ERR on failure
+ * @param       p_tv    how long to wait, NULL waits forever, {0, 0} fails
+ *                      with EAGAIN right away
+ *****************************************************************************/
+int k_sem_wait(int sem, TIMEVAL *p_tv)
+{
+#ifdef DEBUG_0
+    printf("k_sem_wait: sem = %d, p_tv = 0x%x\r\n", sem, p_tv);
+#endif /* DEBUG_0 */
+    U32 timeout = k_tv_to_ticks(p_tv);
+    SEM *p_sem;
+
+    if (sem < 0 || sem >= MAX_SEMS || !g_sems[sem].used) {
+        errno = EINVAL;
+        return RTX_ERR;
+    }
+    p_sem = &g_sems[sem];
+    if (p_sem->count > 0) {
+        p_sem->count--;
+        return RTX_OK;
+    }
+    if (timeout == 0) {
+        errno = EAGAIN;
+        return RTX_ERR;
+    }
+    gp_current_task->timed_out = 0;
+    if (timeout != TMO_FOREVER) {
+        k_tmo_arm(gp_current_task, timeout);
+    }
+    gp_current_task->blk_on = sem;
+    gp_current_task->state = BLK_SEM;
+    k_sync_enqueue(&p_sem->wait, gp_current_task);
+    k_tsk_run_new();
+    if (gp_current_task->timed_out) {
+        errno = ETIMEDOUT;
+        return RTX_ERR;
+    }
+    return RTX_OK;                  // k_sem_post handed us its unit
+}
+
+/**************************************************************************//**
+ * @brief       release one unit, to the most urgent waiter if there is one
+ * @return      RTX_OK on success; RTX_ERR on failure
+ *****************************************************************************/
+int k_sem_post(int sem)
+{
+#ifdef DEBUG_0
+    printf("k_sem_post: sem = %d\r\n", sem);
+#endif /* DEBUG_0 */
+    TCB *p_tcb;
+
+    if (sem < 0 || sem >= MAX_SEMS || !g_sems[sem].used) {
+        errno = EINVAL;
+        return RTX_ERR;
+    }
+    p_tcb = q_list_first_entry_or_null(&g_sems[sem].wait);
+    if (p_tcb == NULL) {
+        g_sems[sem].count++;
+        return RTX_OK;
+    }
+    k_sync_wake(p_tcb);
+    k_sync_preempt(p_tcb);
+    return RTX_OK;
+}
+
+int k_mutex_create(void)
+{
+#ifdef DEBUG_0
+    printf("k_mutex_create: entering...\r\n");
+#endif /* DEBUG_0 */
+    for (int i = 0; i < MAX_MUTEXES; i++) {
+        if (!g_mutexes[i].used) {
+            g_mutexes[i].used  = 1;
+            g_mutexes[i].owner = NULL;
+            return i;
+        }
+    }
+    errno = ENOMEM;
+    return RTX_ERR;
+}
+
+/**************************************************************************//**
+ * @brief       lock a mutex, blocking while another task holds it
+ * @return      RTX_OK on success; RTX_ERR on failure
+ * @details     While the caller waits, the owner runs at the caller's
+ *              priority if that is higher than its own.
+ *****************************************************************************/
+int k_mutex_lock(int mutex)
+{
+#ifdef DEBUG_0
+    printf("k_mutex_lock: mutex = %d\r\n", mutex);
+#endif /* DEBUG_0 */
+    MUTEX *p_mutex;
+
+    if (mutex < 0 || mutex >= MAX_MUTEXES || !g_mutexes[mutex].used) {
+        errno = EINVAL;
+        return RTX_ERR;
+    }
+    p_mutex = &g_mutexes[mutex];
+    if (p_mutex->owner == NULL) {
+        p_mutex->owner = gp_current_task;
+        return RTX_OK;
+    }
+    if (p_mutex->owner == gp_current_task) {
+        errno = EDEADLK;
+        return RTX_ERR;
+    }
+    gp_current_task->blk_on = mutex;
+    gp_current_task->state = BLK_MUTEX;
+    k_sync_enqueue(&p_mutex->wait, gp_current_task);
+    if (!gp_current_task->rt_flag) {
+        k_mutex_inherit(p_mutex, gp_current_task->prio);
+    }
+    k_tsk_run_new();
+    return RTX_OK;                  // k_mutex_unlock made us the owner
+}
+
+int k_mutex_unlock(int mutex)
+{
+#ifdef DEBUG_0
+    printf("k_mutex_unlock: mutex = %d\r\n", mutex);
+#endif /* DEBUG_0 */
+    TCB *p_next;
+
+    if (mutex < 0 || mutex >= MAX_MUTEXES || !g_mutexes[mutex].used) {
+        errno = EINVAL;
+        return RTX_ERR;
+    }
+    if (g_mutexes[mutex].owner != gp_current_task) {
+        errno = EPERM;
+        return RTX_ERR;
+    }
+    p_next = k_mutex_handoff(&g_mutexes[mutex]);
+    k_mutex_restore(gp_current_task);
+    if (p_next != NULL) {
+        k_sync_preempt(p_next);
+    }
+    return RTX_OK;
+}
+
+/**************************************************************************//**
+ * @brief       block on a futex word while it still holds val
+ * @return      RTX_OK once woken by futex_wake; RTX_ERR on failure, with
+ *              EAGAIN if *addr no longer holds val
+ * @details     The compare and the enqueue happen inside one SVC, so a
+ *              futex_wake issued after the caller saw val cannot be missed.
+ *****************************************************************************/
+int k_futex_wait(volatile U32 *addr, U32 val)
+{
+#ifdef DEBUG_0
+    printf("k_futex_wait: addr = 0x%x, val = %u\r\n", addr, val);
+#endif /* DEBUG_0 */
+    if (addr == NULL) {
+        errno = EFAULT;
+        return RTX_ERR;
+    }
+    if (((U32) addr & 3) != 0) {
+        errno = EINVAL;
+        return RTX_ERR;
+    }
+    if (*addr != val) {
+        errno = EAGAIN;
+        return RTX_ERR;
+    }
+    gp_current_task->futex = addr;
+    gp_current_task->state = BLK_FUTEX;
+    k_sync_enqueue(k_futex_bucket(addr), gp_current_task);
+    k_tsk_run_new();
+    return RTX_OK;
+}
+
+/**************************************************************************//**
+ * @brief       wake up to n tasks waiting on a futex word, most urgent first
+ * @return      number of tasks woken; RTX_ERR on failure
+ *****************************************************************************/
+int k_futex_wake(volatile U32 *addr, int n)
+{
+#ifdef DEBUG_0
+    printf("k_futex_wake: addr = 0x%x, n = %d\r\n", addr, n);
+#endif /* DEBUG_0 */
+    TCB *head = k_futex_bucket(addr);
+    TCB *p_tcb = head->next;
+    TCB *p_first = NULL;
+    int woken = 0;
+
+    if (addr == NULL) {
+        errno = EFAULT;
+        return RTX_ERR;
+    }
+    while (p_tcb != head && woken < n) {
+        TCB *p_next = p_tcb->next;
+        if (p_tcb->futex == addr) {
+            p_tcb->futex = NULL;
+            k_sync_wake(p_tcb);
+            if (p_first == NULL) {
+                p_first = p_tcb;
+            }
+            woken++;
+        }
+        p_tcb = p_next;
+    }
+    if (p_first != NULL) {
+        k_sync_preempt(p_first);
+    }
+    return woken;
+}
+
+/**************************************************************************//**
+ * @brief       create an event group with all flags clear
+ * @return      event group ID on success; RTX_ERR on failure
+ *****************************************************************************/
+int k_evt_create(void)
+{
+#ifdef DEBUG_0
+    printf("k_evt_create: entering...\r\n");
+#endif /* DEBUG_0 */
+    for (int i = 0; i < MAX_EVT_GROUPS; i++) {
+        if (!g_evts[i].used) {
+            g_evts[i].used  = 1;
+            g_evts[i].flags = 0;
+            return i;
+        }
+    }
+    errno = ENOMEM;
+    return RTX_ERR;
+}
+
+/**************************************************************************//**
+ * @brief   does flags satisfy what the waiter asked for
+ *****************************************************************************/
+static BOOL k_evt_match(U32 flags, U32 mask, U8 opts)
+{
+    if (opts & EVT_WAIT_ALL) {
+        return (flags & mask) == mask;
+    }
+    return (flags & mask) != 0;
+}
+
+/**************************************************************************//**
+ * @brief       set flags of an event group and wake the waiters they satisfy
+ * @return      the most urgent task woken; NULL if none, or with errno
+ *              EINVAL for a bad group
+ * @note        safe to call from an ISR. One pass over the waiters: each
+ *              satisfied waiter sees the flags as set here, EVT_CLEAR bits
+ *              are cleared after the pass so every waiter can match them.
+ *****************************************************************************/
+TCB *k_evt_set_isr(int grp, U32 bits)
+{
+    EVT_GROUP *p_evt;
+    TCB *p_tcb;
+    TCB *p_first = NULL;
+    U32 clear = 0;
+
+    if (grp < 0 || grp >= MAX_EVT_GROUPS || !g_evts[grp].used) {
+        errno = EINVAL;
+        return NULL;
+    }
+    p_evt = &g_evts[grp];
+    p_evt->flags |= bits;
+    p_tcb = p_evt->wait.next;
+    while (p_tcb != &p_evt->wait) {
+        TCB *p_next = p_tcb->next;
+        if (k_evt_match(p_evt->flags, p_tcb->evt_mask, p_tcb->evt_opts)) {
+            p_tcb->evt_mask = p_evt->flags;     // what the waiter returns
+            if (p_tcb->evt_opts & EVT_CLEAR) {
+                clear |= p_tcb->evt_mask & p_tcb->evt_want;
+            }
+            k_sync_wake(p_tcb);
+            if (p_first == NULL) {
+                p_first = p_tcb;                // the list is in priority order
+            }
+        }
+        p_tcb = p_next;
+    }
+    p_evt->flags &= ~clear;
+    return p_first;
+}
+
+int k_evt_set(int grp, U32 bits)
+{
+#ifdef DEBUG_0
+    printf("k_evt_set: grp = %d, bits = 0x%x\r\n", grp, bits);
+#endif /* DEBUG_0 */
+    TCB *p_first;
+
+    if (grp < 0 || grp >= MAX_EVT_GROUPS || !g_evts[grp].used) {
+        errno = EINVAL;
+        return RTX_ERR;
+    }
+    p_first = k_evt_set_isr(grp, bits);
+    if (p_first != NULL) {
+        k_sync_preempt(p_first);
+    }
+    return RTX_OK;
+}
+
+int k_evt_clear(int grp, U32 bits)
+{
+#ifdef DEBUG_0
+    printf("k_evt_clear: grp = %d, bits = 0x%x\r\n", grp, bits);
+#endif /* DEBUG_0 */
+    if (grp < 0 || grp >= MAX_EVT_GROUPS || !g_evts[grp].used) {
+        errno = EINVAL;
+        return RTX_ERR;
+    }
+    g_evts[grp].flags &= ~bits;
+    return RTX_OK;
+}
+
+/**************************************************************************//**
+ * @brief       wait for flags of an event group
+ * @return      the group flags that satisfied the wait, taken before any
+ *              clearing; 0 on failure with errno ETIMEDOUT, or EAGAIN for
+ *              a {0, 0} timeout
+ * @param       mask    flags to wait for, must not be 0
+ * @param       opts    EVT_WAIT_ANY or EVT_WAIT_ALL, optionally ORed with
+ *                      EVT_CLEAR to clear the mask flags on the way out
+ * @param       p_tv    how long to wait, NULL waits forever
+ *****************************************************************************/
+U32 k_evt_wait(int grp, U32 mask, int opts, TIMEVAL *p_tv)
+{
+#ifdef DEBUG_0
+    printf("k_evt_wait: grp = %d, mask = 0x%x, opts = %d\r\n", grp, mask, opts);
+#endif /* DEBUG_0 */
+    U32 timeout = k_tv_to_ticks(p_tv);
+    EVT_GROUP *p_evt;
+    U32 flags;
+
+    if (grp < 0 || grp >= MAX_EVT_GROUPS || !g_evts[grp].used || mask == 0) {
+        errno = EINVAL;
+        return 0;
+    }
+    p_evt = &g_evts[grp];
+    if (k_evt_match(p_evt->flags, mask, opts)) {
+        flags = p_evt->flags;
+        if (opts & EVT_CLEAR) {
+            p_evt->flags &= ~mask;
+        }
+        return flags;
+    }
+    if (timeout == 0) {
+        errno = EAGAIN;
+        return 0;
+    }
+    gp_current_task->timed_out = 0;
+    if (timeout != TMO_FOREVER) {
+        k_tmo_arm(gp_current_task, timeout);
+    }
+    gp_current_task->evt_mask = mask;
+    gp_current_task->evt_want = mask;
+    gp_current_task->evt_opts = opts;
+    gp_current_task->blk_on = grp;
+    gp_current_task->state = BLK_EVENT;
+    k_sync_enqueue(&p_evt->wait, gp_current_task);
+    k_tsk_run_new();
+    if (gp_current_task->timed_out) {
+        errno = ETIMEDOUT;
+        return 0;
+    }
+    return gp_current_task->evt_mask;   // k_evt_set_isr left the flags here
+}
+
+/**************************************************************************//**
+ * @brief   pass on every mutex held by the calling task, used on exit
+ *****************************************************************************/
+void k_mutex_release_all(void)
+{
+    for (int i = 0; i < MAX_MUTEXES; i++) {
+        if (g_mutexes[i].owner == gp_current_task) {
+            k_mutex_handoff(&g_mutexes[i]);
+        }
+    }
+}
+
+/*
+ *===========================================================================
+ *                             END OF FILE
+ *===========================================================================
+ */
@@ -0,0 +1,117 @@
+/*
+ ****************************************************************************
+ *
+ *                  UNIVERSITY OF WATERLOO ECE 350 RTX LAB  
+ *
+ *                     Copyright 2020-2022 Yiqing Huang
+ *                          All rights reserved.
+ *---------------------------------------------------------------------------
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice and the following disclaimer.
+ *
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS AND CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *---------------------------------------------------------------------------*/
+ 
+
+/**************************************************************************//**
+ * @file        k_sync.h
+ * @brief       kernel semaphores, mutexes, futexes and event groups header file
+ *
+ * @note        waiters are kept in priority order, FIFO within a priority,
+ *              futex waiters share a few lists hashed by address
+ *****************************************************************************/
+
+#ifndef K_SYNC_H_
+#define K_SYNC_H_
+
+#include "k_inc.h"
+
+/*
+ *===========================================================================
+ *                             MACROS
+ *===========================================================================
+ */
+
+#define FUTEX_HASH      8       /* futex wait lists, must be a power of two */
+
+/*
+ *===========================================================================
+ *                             STRUCTURES
+ *===========================================================================
+ */
+
+typedef struct k_sem {
+    S32         count;          /**< units available                    */
+    U8          used;           /**< slot taken by sem_create           */
+    TCB         wait;           /**< BLK_SEM waiters, list head         */
+} SEM;
+
+typedef struct k_mutex {
+    TCB        *owner;          /**< holder, NULL if unlocked           */
+    U8          used;           /**< slot taken by mutex_create         */
+    TCB         wait;           /**< BLK_MUTEX waiters, list head       */
+} MUTEX;
+
+typedef struct k_evt_group {
+    U32         flags;          /**< the 32 event flags                 */
+    U8          used;           /**< slot taken by evt_create           */
+    TCB         wait;           /**< BLK_EVENT waiters, list head       */
+} EVT_GROUP;
+
+/*
+ *===========================================================================
+ *                            GLOBAL VARIABLES
+ *===========================================================================
+ */
+
+extern SEM   g_sems[MAX_SEMS];
+extern MUTEX g_mutexes[MAX_MUTEXES];
+extern TCB   g_futex_wait[FUTEX_HASH];
+extern EVT_GROUP g_evts[MAX_EVT_GROUPS];
+
+/*
+ *===========================================================================
+ *                            FUNCTION PROTOTYPES
+ *===========================================================================
+ */
+
+void k_sync_init        (void);
+void k_sync_enqueue     (TCB *head, TCB *p_tcb);
+void k_sync_wake        (TCB *p_tcb);
+void k_sync_preempt     (TCB *p_tcb);
+void k_sync_set_base_prio(TCB *p_tcb, U8 prio);
+int  k_sem_create       (int count);
+int  k_sem_wait         (int sem, TIMEVAL *p_tv);
+int  k_sem_post         (int sem);
+int  k_mutex_create     (void);
+int  k_mutex_lock       (int mutex);
+int  k_mutex_unlock     (int mutex);
+void k_mutex_release_all(void);
+int  k_futex_wait       (volatile U32 *addr, U32 val);
+int  k_futex_wake       (volatile U32 *addr, int n);
+int  k_evt_create       (void);
+TCB  *k_evt_set_isr     (int grp, U32 bits);
+int  k_evt_set          (int grp, U32 bits);
+int  k_evt_clear        (int grp, U32 bits);
+U32  k_evt_wait         (int grp, U32 mask, int opts, TIMEVAL *p_tv);
+
+#endif // ! K_SYNC_H_
+
+/*
+ *===========================================================================
+ *                             END OF FILE
+ *===========================================================================
+ */
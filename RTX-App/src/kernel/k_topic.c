@@ -0,0 +1,251 @@
+/*
+ ****************************************************************************
+ *
+ *                  UNIVERSITY OF WATERLOO ECE 350 RTX LAB  
+ *
+ *                     Copyright 2020-2022 Yiqing Huang
+ *                          All rights reserved.
+ *---------------------------------------------------------------------------
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice and the following disclaimer.
+ *
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS AND CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *---------------------------------------------------------------------------*/
+ 
+
+/**************************************************************************//**
+ * @file        k_topic.c
+ * @brief       kernel publish/subscribe topics
+ *
+ * @details     A publish copies the message once into a reference counted
+ *              zero-copy buffer and queues only a MSG_ZC record in every
+ *              subscribed mailbox. Receivers copy out with recv_msg or map
+ *              the shared, read-only payload with recv_msg_zc, the last
+ *              reference dropped frees it. What happens when a subscriber
+ *              mailbox is full is chosen per subscription.
+ *****************************************************************************/
+
+#include "k_inc.h"
+#include "k_rtx.h"
+#include "k_task.h"
+#include "k_msg.h"
+#include "k_topic.h"
+
+TOPIC g_topics[MAX_TOPICS];
+
+void k_topic_init(void)
+{
+    for (int i = 0; i < MAX_TOPICS; i++) {
+        for (int j = 0; j < MAX_TOPIC_SUBS; j++) {
+            g_topics[i].subs[j].mbx = -1;
+        }
+        g_topics[i].num_subs = 0;
+    }
+}
+
+/**************************************************************************//**
+ * @brief       subscribe a mailbox of the calling task to a topic
+ * @return      RTX_OK on success; RTX_ERR on failure
+ * @param       topic   topic ID, 0 to MAX_TOPICS - 1
+ * @param       mbx     the mailbox to deliver to
+ * @param       policy  TOPIC_DROP, TOPIC_BLOCK or TOPIC_OVERWRITE, what a
+ *                      publish does when this mailbox is full
+ * @note        subscribing again only changes the policy
+ *****************************************************************************/
+int k_topic_subscribe(int topic, mbx_t mbx, int policy)
+{
+#ifdef DEBUG_0
+    printf("k_topic_subscribe: topic = %d, mbx = %d, policy = %d\r\n", topic, mbx, policy);
+#endif /* DEBUG_0 */
+    RB *p_mbx = k_mbx_lookup(mbx);
+    TOPIC_SUB *p_free = NULL;
+
+    if (p_mbx == NULL) {
+        return RTX_ERR;
+    }
+    if (topic < 0 || topic >= MAX_TOPICS || policy < TOPIC_DROP || policy > TOPIC_OVERWRITE) {
+        errno = EINVAL;
+        return RTX_ERR;
+    }
+    if (p_mbx->owner != gp_current_task->tid) {
+        errno = EPERM;
+        return RTX_ERR;
+    }
+    for (int i = 0; i < MAX_TOPIC_SUBS; i++) {
+        TOPIC_SUB *p_sub = &g_topics[topic].subs[i];
+        if (p_sub->mbx == mbx) {
+            p_sub->policy = policy;
+            return RTX_OK;
+        }
+        if (p_sub->mbx == -1 && p_free == NULL) {
+            p_free = p_sub;
+        }
+    }
+    if (p_free == NULL) {
+        errno = ENOSPC;
+        return RTX_ERR;
+    }
+    p_free->mbx = mbx;
+    p_free->policy = policy;
+    g_topics[topic].num_subs++;
+    return RTX_OK;
+}
+
+int k_topic_unsubscribe(int topic, mbx_t mbx)
+{
+#ifdef DEBUG_0
+    printf("k_topic_unsubscribe: topic = %d, mbx = %d\r\n", topic, mbx);
+#endif /* DEBUG_0 */
+    RB *p_mbx = k_mbx_lookup(mbx);
+
+    if (p_mbx == NULL) {
+        return RTX_ERR;
+    }
+    if (topic < 0 || topic >= MAX_TOPICS) {
+        errno = EINVAL;
+        return RTX_ERR;
+    }
+    if (p_mbx->owner != gp_current_task->tid) {
+        errno = EPERM;
+        return RTX_ERR;
+    }
+    for (int i = 0; i < MAX_TOPIC_SUBS; i++) {
+        if (g_topics[topic].subs[i].mbx == mbx) {
+            g_topics[topic].subs[i].mbx = -1;
+            g_topics[topic].num_subs--;
+            return RTX_OK;
+        }
+    }
+    errno = ENOENT;
+    return RTX_ERR;
+}
+
+/**************************************************************************//**
+ * @brief   remove a mailbox from every topic, called when it is deleted
+ *****************************************************************************/
+void k_topic_drop_mbx(mbx_t mbx)
+{
+    for (int i = 0; i < MAX_TOPICS; i++) {
+        for (int j = 0; j < MAX_TOPIC_SUBS; j++) {
+            if (g_topics[i].subs[j].mbx == mbx) {
+                g_topics[i].subs[j].mbx = -1;
+                g_topics[i].num_subs--;
+            }
+        }
+    }
+}
+
+/**************************************************************************//**
+ * @brief   make room for one record by discarding the oldest messages
+ *****************************************************************************/
+static void k_topic_evict(RB *p_mbx)
+{
+    ZC_REC rec;
+    int evicted = 0;
+
+    while (k_mbx_space(p_mbx) < (int) MSG_RB_LEN(sizeof(ZC_REC)) && !check_rb_empty(p_mbx)) {
+        if (get_msg_type(p_mbx) == MSG_ZC) {
+            k_mbx_peek(p_mbx, &rec, sizeof(ZC_REC));
+            k_zc_put(rec.msg);
+        }
+        k_mbx_pop(p_mbx, NULL);
+        evicted = 1;
+    }
+    if (evicted) {
+        k_mbx_wake_sender(p_mbx);   // blocked senders may fit now, they queue ahead of the publisher
+    }
+}
+
+/**************************************************************************//**
+ * @brief       publish a message to every subscriber of a topic
+ * @return      number of mailboxes the message was delivered to;
+ *              RTX_ERR on failure
+ * @param       topic   topic ID
+ * @param       buf     the message, starting with its RTX_MSG_HDR
+ * @details     The payload is copied once. A TOPIC_BLOCK subscriber with a
+ *              full mailbox blocks the publisher like send_msg does, a
+ *              TOPIC_DROP subscriber misses the message, a TOPIC_OVERWRITE
+ *              subscriber loses its oldest queued messages instead.
+ *****************************************************************************/
+int k_topic_publish(int topic, const void *buf)
+{
+#ifdef DEBUG_0
+    printf("k_topic_publish: topic = %d, buf = 0x%x\r\n", topic, buf);
+#endif /* DEBUG_0 */
+    RTX_MSG_HDR *p_hdr = (RTX_MSG_HDR *) buf;
+    void        *payload;
+    ZC_BUF      *p_zc;
+    ZC_REC       rec;
+    int          delivered = 0;
+
+    if (topic < 0 || topic >= MAX_TOPICS) {
+        errno = EINVAL;
+        return RTX_ERR;
+    }
+    if (buf == NULL) {
+        errno = EFAULT;
+        return RTX_ERR;
+    }
+    if (p_hdr->length < MIN_MSG_SIZE || p_hdr->type == MSG_ZC) {
+        errno = EINVAL;
+        return RTX_ERR;
+    }
+    if (g_topics[topic].num_subs == 0) {
+        return 0;
+    }
+
+    payload = k_msg_alloc(p_hdr->length);
+    if (payload == NULL) {
+        return RTX_ERR;
+    }
+    cpymem(payload, buf, p_hdr->length);
+    p_zc = k_zc_lookup(payload);
+    p_zc->length = p_hdr->length;
+    p_zc->owner  = ZC_SHARED;                   // our own reference keeps it alive while we block
+
+    rec.hdr.length     = sizeof(ZC_REC);
+    rec.hdr.sender_tid = gp_current_task->tid;
+    rec.hdr.type       = MSG_ZC;
+    rec.msg            = payload;
+
+    for (int i = 0; i < MAX_TOPIC_SUBS; i++) {
+        TOPIC_SUB *p_sub = &g_topics[topic].subs[i];
+        U32 timeout = 0;
+
+        if (p_sub->mbx == -1) {
+            continue;
+        }
+        if (p_sub->policy == TOPIC_BLOCK) {
+            timeout = TMO_FOREVER;
+        } else if (p_sub->policy == TOPIC_OVERWRITE) {
+            k_topic_evict(&mailboxes[p_sub->mbx]);
+        }
+        p_zc->refcnt++;
+        if (k_mbx_send(p_sub->mbx, &rec, timeout) == RTX_OK) {
+            delivered++;
+        } else {
+            p_zc->refcnt--;
+        }
+    }
+    k_zc_put(payload);
+    return delivered;
+}
+
+/*
+ *===========================================================================
+ *                             END OF FILE
+ *===========================================================================
+ */
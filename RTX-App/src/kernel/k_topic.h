@@ -0,0 +1,76 @@
+/*
+ ****************************************************************************
+ *
+ *                  UNIVERSITY OF WATERLOO ECE 350 RTX LAB  
+ *
+ *                     Copyright 2020-2022 Yiqing Huang
+ *                          All rights reserved.
+ *---------------------------------------------------------------------------
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice and the following disclaimer.
+ *
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS AND CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *---------------------------------------------------------------------------*/
+ 
+
+/**************************************************************************//**
+ * @file        k_topic.h
+ * @brief       kernel publish/subscribe topics header file
+ *
+ * @note        a topic fans one published message out to the mailboxes
+ *              subscribed to it, all subscribers share one payload
+ *****************************************************************************/
+
+#ifndef K_TOPIC_H_
+#define K_TOPIC_H_
+
+#include "k_inc.h"
+
+/*
+ *===========================================================================
+ *                             STRUCTURES
+ *===========================================================================
+ */
+
+typedef struct k_topic_sub {
+    mbx_t       mbx;                    /**< subscribed mailbox, -1 if free   */
+    U8          policy;                 /**< TOPIC_DROP, _BLOCK or _OVERWRITE */
+} TOPIC_SUB;
+
+typedef struct k_topic {
+    TOPIC_SUB   subs[MAX_TOPIC_SUBS];   /**< subscriber slots                 */
+    U8          num_subs;               /**< number of used slots             */
+} TOPIC;
+
+/*
+ *===========================================================================
+ *                            FUNCTION PROTOTYPES
+ *===========================================================================
+ */
+
+void k_topic_init           (void);
+int  k_topic_subscribe      (int topic, mbx_t mbx, int policy);
+int  k_topic_unsubscribe    (int topic, mbx_t mbx);
+int  k_topic_publish        (int topic, const void *buf);
+void k_topic_drop_mbx       (mbx_t mbx);
+
+#endif // ! K_TOPIC_H_
+
+/*
+ *===========================================================================
+ *                             END OF FILE
+ *===========================================================================
+ */
@@ -0,0 +1,134 @@
+/*
+ ****************************************************************************
+ *
+ *                  UNIVERSITY OF WATERLOO ECE 350 RTX LAB  
+ *
+ *                     Copyright 2020-2022 Yiqing Huang
+ *                          All rights reserved.
+ *---------------------------------------------------------------------------
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice and the following disclaimer.
+ *
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS AND CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *---------------------------------------------------------------------------*/
+ 
+
+/**************************************************************************//**
+ * @file        chan.c
+ * @brief       user space side of shared-memory channels
+ *
+ * @details     head and tail count bytes from the start and only ever grow,
+ *              the ring index is the count modulo the power of two size.
+ *              The producer alone writes head, the consumer alone writes
+ *              tail. Data is copied before the index moves, so the other
+ *              side never sees bytes that are not there yet.
+ *****************************************************************************/
+
+#include <string.h>
+#include "rtx.h"
+
+/**************************************************************************//**
+ * @brief   copy n bytes into the ring at byte count pos
+ *****************************************************************************/
+static void chan_copy_in(CHAN_RING *ring, U32 pos, const U8 *src, U32 n)
+{
+    U32 off   = pos & (ring->size - 1);
+    U32 first = ring->size - off;
+
+    if (n <= first) {
+        memcpy(CHAN_DATA(ring) + off, src, n);
+    } else {
+        memcpy(CHAN_DATA(ring) + off, src, first);
+        memcpy(CHAN_DATA(ring), src + first, n - first);
+    }
+}
+
+static void chan_copy_out(CHAN_RING *ring, U32 pos, U8 *dst, U32 n)
+{
+    U32 off   = pos & (ring->size - 1);
+    U32 first = ring->size - off;
+
+    if (n <= first) {
+        memcpy(dst, CHAN_DATA(ring) + off, n);
+    } else {
+        memcpy(dst, CHAN_DATA(ring) + off, first);
+        memcpy(dst + first, CHAN_DATA(ring), n - first);
+    }
+}
+
+/**************************************************************************//**
+ * @brief   write all n bytes, waiting for room while the ring is full
+ * @return  n on success; RTX_ERR if chan_wait failed, errno tells why
+ *****************************************************************************/
+int chan_write(CHAN_RING *ring, const void *buf, size_t n)
+{
+    const U8 *src = buf;
+    size_t left = n;
+
+    while (left > 0) {
+        U32 head = ring->head;
+        U32 room = ring->size - (head - ring->tail);
+
+        if (room == 0) {
+            if (chan_wait(ring->chan, NULL) != RTX_OK) {
+                return RTX_ERR;
+            }
+            continue;
+        }
+        if (room > left) {
+            room = left;
+        }
+        chan_copy_in(ring, head, src, room);
+        ring->head = head + room;
+        if (ring->waiting == CHAN_WAIT_DATA) {
+            chan_wake(ring->chan);      // the ring was empty, the consumer is parked
+        }
+        src  += room;
+        left -= room;
+    }
+    return n;
+}
+
+/**************************************************************************//**
+ * @brief   read up to n bytes, waiting while the ring is empty
+ * @return  bytes read, at least 1; RTX_ERR if chan_wait failed
+ *****************************************************************************/
+int chan_read(CHAN_RING *ring, void *buf, size_t n)
+{
+    U32 tail = ring->tail;
+    U32 avail;
+
+    while ((avail = ring->head - tail) == 0) {
+        if (chan_wait(ring->chan, NULL) != RTX_OK) {
+            return RTX_ERR;
+        }
+    }
+    if (avail > n) {
+        avail = n;
+    }
+    chan_copy_out(ring, tail, buf, avail);
+    ring->tail = tail + avail;
+    if (ring->waiting == CHAN_WAIT_ROOM) {
+        chan_wake(ring->chan);          // the ring was full, the producer is parked
+    }
+    return avail;
+}
+
+/*
+ *===========================================================================
+ *                             END OF FILE
+ *===========================================================================
+ */
@@ -0,0 +1,104 @@
+/*
+ ****************************************************************************
+ *
+ *                  UNIVERSITY OF WATERLOO ECE 350 RTX LAB  
+ *
+ *                     Copyright 2020-2022 Yiqing Huang
+ *                          All rights reserved.
+ *---------------------------------------------------------------------------
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice and the following disclaimer.
+ *
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS AND CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *---------------------------------------------------------------------------*/
+ 
+
+/**************************************************************************//**
+ * @file        futex.c
+ * @brief       user space locks on a futex word
+ *
+ * @details     The lock word is FUTEX_UNLOCKED when free, FUTEX_LOCKED
+ *              when held and FUTEX_CONTENDED when held with possible
+ *              waiters. Taking a free lock and releasing one
+ *              nobody waits for are a single LDREX/STREX pair in the
+ *              calling task, only contention enters the kernel through
+ *              futex_wait and futex_wake. An exception clears the
+ *              exclusive monitor, so a task switched out between LDREX and
+ *              STREX simply retries.
+ *****************************************************************************/
+
+#include "rtx.h"
+
+/**************************************************************************//**
+ * @brief   store new_val if *futex equals old_val
+ * @return  the value found in *futex
+ *****************************************************************************/
+static U32 futex_cas(volatile U32 *futex, U32 old_val, U32 new_val)
+{
+    U32 cur;
+
+    do {
+        cur = __ldrex(futex);
+        if (cur != old_val) {
+            __clrex();
+            return cur;
+        }
+    } while (__strex(new_val, futex) != 0);
+    return cur;
+}
+
+/**************************************************************************//**
+ * @brief   store new_val unconditionally
+ * @return  the previous value of *futex
+ *****************************************************************************/
+static U32 futex_xchg(volatile U32 *futex, U32 new_val)
+{
+    U32 cur;
+
+    do {
+        cur = __ldrex(futex);
+    } while (__strex(new_val, futex) != 0);
+    return cur;
+}
+
+void futex_lock(volatile U32 *futex)
+{
+    U32 cur = futex_cas(futex, FUTEX_UNLOCKED, FUTEX_LOCKED);
+
+    if (cur == FUTEX_UNLOCKED) {
+        return;                         // uncontended, no kernel entry
+    }
+    if (cur != FUTEX_CONTENDED) {
+        cur = futex_xchg(futex, FUTEX_CONTENDED);   // announce a waiter
+    }
+    while (cur != FUTEX_UNLOCKED) {
+        futex_wait(futex, FUTEX_CONTENDED);         // returns at once if the word changed
+        cur = futex_xchg(futex, FUTEX_CONTENDED);
+    }
+}
+
+void futex_unlock(volatile U32 *futex)
+{
+    if (futex_xchg(futex, FUTEX_UNLOCKED) == FUTEX_CONTENDED) {
+        futex_wake(futex, 1);
+    }
+}
+
+/*
+ *===========================================================================
+ *                             END OF FILE
+ *===========================================================================
+ */
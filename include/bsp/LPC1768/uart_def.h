@@ -1,95 +1,95 @@
-/*
- ****************************************************************************
- *
- *                  UNIVERSITY OF WATERLOO ECE 350 RTOS LAB  
- *
- *                     Copyright 2020-2022 Yiqing Huang
- *                          All rights reserved.
- *---------------------------------------------------------------------------
- *  Redistribution and use in source and binary forms, with or without
- *  modification, are permitted provided that the following conditions are met:
- *  - Redistributions of source code must retain the above copyright
- *    notice and the following disclaimer.
- *
- *
- *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
- *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
- *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
- *  ARE DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS AND CONTRIBUTORS BE
- *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
- *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
- *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
- *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
- *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
- *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
- *  POSSIBILITY OF SUCH DAMAGE.
- *---------------------------------------------------------------------------*/
- 
-
-/**************************************************************************//**
- * @file        uart_def.h 
- * @brief       UART defines
- *              
- * @version     V1.2021.01
- * @authors     Yiqing Huang
- * @date        2021 JAN
- * @note        part of the code is from uart.h from NXP 
- * @details
- *
- *****************************************************************************/
-
-#ifndef UART_DEF_H_
-#define UART_DEF_H_
-
-/* The following macros are from NXP uart.h */
-#define IER_RBR		0x01
-#define IER_THRE	0x02
-#define IER_RLS		0x04
-
-#define IIR_PEND	0x01
-#define IIR_RLS		0x03
-#define IIR_RDA		0x02
-#define IIR_CTI		0x06
-#define IIR_THRE	0x01
-
-#define LSR_RDR		0x01
-#define LSR_OE		0x02
-#define LSR_PE		0x04
-#define LSR_FE		0x08
-#define LSR_BI		0x10
-#define LSR_THRE	0x20
-#define LSR_TEMT	0x40
-#define LSR_RXFE	0x80
-
-#define BUFSIZE		0x40
-/* end of NXP uart.h file reference */
-
-
-/* convenient macro for bit operation */
-#define BIT(X)      ( 1UL << (X) )
-
-/* 
-   8 bits, no Parity, 1 Stop bit
-   
-   0x83 = 1000 0011 = 1 0 00 0 0 11
-   LCR[7]  =1  enable Divisor Latch Access Bit DLAB
-   LCR[6]  =0  disable break transmission
-   LCR[5:4]=00 odd parity
-   LCR[3]  =0  no parity
-   LCR[2]  =0  1 stop bit
-   LCR[1:0]=11 8-bit char len
-   See table 279, pg306 LPC17xx_UM
-*/
-#define UART_8N1    0x83
-
-#ifndef NULL
-#define NULL        0
-#endif
-
-#endif /* !UART_DEF_H_ */
-
-/*
- *===========================================================================
- *                             END OF FILE
- *===========================================================================
- */
+/*
+ ****************************************************************************
+ *
+ *                  UNIVERSITY OF WATERLOO ECE 350 RTOS LAB  
+ *
+ *                     Copyright 2020-2022 Yiqing Huang
+ *                          All rights reserved.
+ *---------------------------------------------------------------------------
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice and the following disclaimer.
+ *
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS AND CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *---------------------------------------------------------------------------*/
+ 
+
+/**************************************************************************//**
+ * @file        uart_def.h 
+ * @brief       UART defines
+ *              
+ * @version     V1.2021.01
+ * @authors     Yiqing Huang
+ * @date        2021 JAN
+ * @note        part of the code is from uart.h from NXP 
+ * @details
+ *
+ *****************************************************************************/
+
+#ifndef UART_DEF_H_
+#define UART_DEF_H_
+
+/* The following macros are from NXP uart.h */
+#define IER_RBR		0x01
+#define IER_THRE	0x02
+#define IER_RLS		0x04
+
+#define IIR_PEND	0x01
+#define IIR_RLS		0x03
+#define IIR_RDA		0x02
+#define IIR_CTI		0x06
+#define IIR_THRE	0x01
+
+#define LSR_RDR		0x01
+#define LSR_OE		0x02
+#define LSR_PE		0x04
+#define LSR_FE		0x08
+#define LSR_BI		0x10
+#define LSR_THRE	0x20
+#define LSR_TEMT	0x40
+#define LSR_RXFE	0x80
+
+#define BUFSIZE		0x40
+/* end of NXP uart.h file reference */
+
+
+/* convenient macro for bit operation */
+#define BIT(X)      ( 1UL << (X) )
+
+/* 
+   8 bits, no Parity, 1 Stop bit
+   
+   0x83 = 1000 0011 = 1 0 00 0 0 11
+   LCR[7]  =1  enable Divisor Latch Access Bit DLAB
+   LCR[6]  =0  disable break transmission
+   LCR[5:4]=00 odd parity
+   LCR[3]  =0  no parity
+   LCR[2]  =0  1 stop bit
+   LCR[1:0]=11 8-bit char len
+   See table 279, pg306 LPC17xx_UM
+*/
+#define UART_8N1    0x83
+
+#ifndef NULL
+#define NULL        0
+#endif
+
+#endif /* !UART_DEF_H_ */
+
+/*
+ *===========================================================================
+ *                             END OF FILE
+ *===========================================================================
+ */
@@ -1,81 +1,248 @@
-/*
- ****************************************************************************
- *
- *                  UNIVERSITY OF WATERLOO ECE 350 RTOS LAB
- *
- *                     Copyright 2020-2022 Yiqing Huang
- *                          All rights reserved.
- *
- *  Redistribution and use in source and binary forms, with or without
- *  modification, are permitted provided that the following conditions are met:
- *  - Redistributions of source code must retain the above copyright
- *    notice and the following disclaimer.
- *
- *
- *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
- *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
- *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
- *  ARE DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS AND CONTRIBUTORS BE
- *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
- *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
- *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
- *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
- *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
- *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
- *  POSSIBILITY OF SUCH DAMAGE.
- ****************************************************************************
- */
-
-/**************************************************************************//**
- * @file        common_ext.h
- * @brief       Extended common macros and structures for both kernel and user
- *              for students to add self-defined macros and structures
- * @version     V1.2021.01
- * @authors     Yiqing Huang
- * @date        2021 JAN
- *
- * @see         common.h
- *
- * @note        If you want to define your own macros and data structures,
- *              add them to common_ext.h.
- *              Do not let your newly-added code cause conflicts with
- *              the existing code in this file.
- *              For example, if you want to define new message types,
- *              use a value starting from 10.
- *              Do not overwrite existing message type macro values.
- *
- *****************************************************************************/
-
-/*
- *===========================================================================
- *                             MACROS
- *===========================================================================
- */
-
-/*
- *===========================================================================
- *                             TYPEDEFS
- *===========================================================================
- */
-
-
-/*
- *===========================================================================
- *                             STRUCTURES
- *===========================================================================
- */
- 
-
-
- /*
-  *===========================================================================
-  *                            FUNCTION PROTOTYPES
-  *===========================================================================
-  */
-
-
- /*
-  *===========================================================================
-  *                             END OF FILE
-  *===========================================================================
-  */
+/*
+ ****************************************************************************
+ *
+ *                  UNIVERSITY OF WATERLOO ECE 350 RTOS LAB
+ *
+ *                     Copyright 2020-2022 Yiqing Huang
+ *                          All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice and the following disclaimer.
+ *
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS AND CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ ****************************************************************************
+ */
+
+/**************************************************************************//**
+ * @file        common_ext.h
+ * @brief       Extended common macros and structures for both kernel and user
+ *              for students to add self-defined macros and structures
+ * @version     V1.2021.01
+ * @authors     Yiqing Huang
+ * @date        2021 JAN
+ *
+ * @see         common.h
+ *
+ * @note        If you want to define your own macros and data structures,
+ *              add them to common_ext.h.
+ *              Do not let your newly-added code cause conflicts with
+ *              the existing code in this file.
+ *              For example, if you want to define new message types,
+ *              use a value starting from 10.
+ *              Do not overwrite existing message type macro values.
+ *
+ *****************************************************************************/
+
+#ifndef COMMON_EXT_H_
+#define COMMON_EXT_H_
+
+/*
+ *===========================================================================
+ *                             MACROS
+ *===========================================================================
+ */
+
+/* Extended Error Codes */
+#define EDEADLK             35      /* the caller already holds the mutex */
+#define ETIMEDOUT           110     /* a blocking call timed out */
+
+/* Extended Message Types */
+#define RT_OVERRUN          10      /* a real-time job was throttled on its budget */
+
+/* Extended Task States */
+#define BLK_POOL            6       /* idle pool worker waiting for a job */
+#define BLK_CALL            7       /* msg_call client waiting for the reply */
+#define BLK_NOTIFY          8       /* waiting in tsk_notify_wait */
+#define BLK_SEM             9       /* waiting for a semaphore unit */
+#define BLK_MUTEX           10      /* waiting for a mutex */
+#define BLK_FUTEX           11      /* waiting in futex_wait */
+#define BLK_EVENT           12      /* waiting for event group flags */
+#define BLK_MSGPOOL         13      /* waiting for a message pool block */
+#define BLK_CHAN            14      /* waiting for channel data or room */
+
+/* Worker Pool Macros */
+#define MAX_POOLS           2       /* maximum number of worker pools */
+#define POOL_MAX_JOBS       8       /* capacity of a pool job queue */
+
+/* Timeout Macros */
+#define TMO_FOREVER         0xFFFFFFFF  /* kernel timeout in ticks meaning no timeout */
+
+/* Mailbox Macros */
+#define MAX_EXTRA_MBX       8       /* mailboxes from mbx_create_ex, on top of one per task */
+#define MAX_MBX             (MAX_TASKS + MAX_EXTRA_MBX)
+#define MBX_FIFO            0       /* messages are delivered in arrival order */
+#define MBX_PRIO            1       /* messages are delivered by sender priority */
+#define MAX_ZC_BUFS         16      /* msg_alloc buffers alive at once */
+
+/* Topic Macros */
+#define MAX_TOPICS          8       /* number of publish/subscribe topics */
+#define MAX_TOPIC_SUBS      8       /* subscribers per topic */
+#define TOPIC_DROP          0       /* full subscriber mailbox: skip it */
+#define TOPIC_BLOCK         1       /* full subscriber mailbox: publisher waits */
+#define TOPIC_OVERWRITE     2       /* full subscriber mailbox: drop its oldest messages */
+
+/* Task Notification Macros */
+#define NOTIFY_SET_BITS     0       /* OR the bits into the notification word */
+#define NOTIFY_INCREMENT    1       /* count up, bits is ignored */
+#define NOTIFY_OVERWRITE    2       /* replace the notification word */
+#define NOTIFY_UART_TX      0x80000000  /* UART0 finished sending a DISPLAY message */
+
+/* Semaphore and Mutex Macros */
+#define MAX_SEMS            8       /* number of counting semaphores */
+#define MAX_MUTEXES         8       /* number of mutexes */
+#define FUTEX_UNLOCKED      0       /* initial value of a futex lock word */
+#define FUTEX_LOCKED        1       /* lock word: held, nobody waits */
+#define FUTEX_CONTENDED     2       /* lock word: held, waiters may sleep on it */
+
+/* Event Group Macros */
+#define MAX_EVT_GROUPS      8       /* number of event groups */
+#define EVT_WAIT_ANY        0x00    /* wake when any mask flag is set */
+#define EVT_WAIT_ALL        0x01    /* wake when all mask flags are set */
+#define EVT_CLEAR           0x02    /* clear the mask flags when the wait succeeds */
+
+/* Message Pool Macros */
+#define MAX_MSGPOOLS        4       /* number of fixed-size message pools */
+
+/* Shared-memory channels */
+#define MAX_CHANS           4       /* number of producer/consumer channels */
+#define CHAN_WAIT_NONE      0       /* CHAN_RING.waiting: nobody parked */
+#define CHAN_WAIT_DATA      1       /* the consumer waits for data */
+#define CHAN_WAIT_ROOM      2       /* the producer waits for room */
+#define CHAN_DATA(p_ring)   ((unsigned char *)((p_ring) + 1))
+
+/* Bandwidth Server Macros */
+#define MAX_CBS             2       /* maximum number of constant bandwidth servers */
+
+/* Extended TRAP NUMBERS */
+#define SVC_POOL_CREATE     0x30
+#define SVC_POOL_SUBMIT     0x31
+#define SVC_POOL_TAKE       0x32
+#define SVC_CBS_CREATE      0x33
+#define SVC_CBS_ATTACH      0x34
+#define SVC_RT_TSK_BUDGET   0x35
+#define SVC_MSG_ALLOC       0x36
+#define SVC_MSG_FREE        0x37
+#define SVC_MBX_SEND_ZC     0x38
+#define SVC_MBX_RECV_ZC     0x39
+#define SVC_MBX_CREATE_EX   0x3A
+#define SVC_MBX_DELETE      0x3B
+#define SVC_MBX_SEND_TO     0x3C
+#define SVC_MBX_SEND_TO_NB  0x3D
+#define SVC_MBX_RECV_FROM   0x3E
+#define SVC_MBX_RECV_FROM_NB 0x3F
+#define SVC_MBX_SEND_TMO    0x40
+#define SVC_MBX_RECV_TMO    0x41
+#define SVC_MBX_SELECT      0x42
+#define SVC_MBX_SET_MODE    0x43
+#define SVC_MBX_SEND_BATCH  0x44
+#define SVC_MBX_RECV_BATCH  0x45
+#define SVC_TOPIC_SUB       0x46
+#define SVC_TOPIC_UNSUB     0x47
+#define SVC_TOPIC_PUB       0x48
+#define SVC_MSG_CALL        0x49
+#define SVC_MSG_REPLY       0x4A
+#define SVC_UART_GETC       0x4B
+#define SVC_TSK_NOTIFY      0x4C
+#define SVC_TSK_NOTIFY_WAIT 0x4D
+#define SVC_SEM_CREATE      0x4E
+#define SVC_SEM_WAIT        0x4F
+#define SVC_SEM_POST        0x50
+#define SVC_MUTEX_CREATE    0x51
+#define SVC_MUTEX_LOCK      0x52
+#define SVC_MUTEX_UNLOCK    0x53
+#define SVC_FUTEX_WAIT      0x54
+#define SVC_FUTEX_WAKE      0x55
+#define SVC_EVT_CREATE      0x56
+#define SVC_EVT_SET         0x57
+#define SVC_EVT_CLEAR       0x58
+#define SVC_EVT_WAIT        0x59
+#define SVC_MSGPOOL_CREATE  0x5A
+#define SVC_MSGPOOL_GET     0x5B
+#define SVC_MSGPOOL_PUT     0x5C
+#define SVC_MBX_PEEK        0x5D
+#define SVC_MBX_RECV_TYPE   0x5E
+#define SVC_MBX_STAT        0x5F
+#define SVC_CHAN_CREATE     0x60
+#define SVC_CHAN_OPEN       0x61
+#define SVC_CHAN_WAIT       0x62
+#define SVC_CHAN_WAKE       0x63
+#define SVC_CHAN_DELETE     0x64
+#define SVC_MSGPOOL_DELETE  0x65
+#define SVC_UART_SELECT     0x66
+
+/*
+ *===========================================================================
+ *                             TYPEDEFS
+ *===========================================================================
+ */
+
+
+/*
+ *===========================================================================
+ *                             STRUCTURES
+ *===========================================================================
+ */
+ 
+/* job handed to a pool worker, plain C types as common.h typedefs come later */
+typedef struct pool_job {
+    void        (*func)(void *);    /**< job entry, called by the worker    */
+    void        *arg;               /**< argument passed to func            */
+} POOL_JOB;
+
+/* mailbox counters returned by mbx_stat, times in RTX_TICK_SIZE ticks */
+typedef struct mbx_stat {
+    unsigned int size;              /**< mailbox size in bytes              */
+    unsigned int used;              /**< bytes queued now                   */
+    unsigned int peak;              /**< most bytes queued at once          */
+    unsigned int msgs_in;           /**< messages queued                    */
+    unsigned int bytes_in;
+    unsigned int msgs_out;          /**< messages received or discarded     */
+    unsigned int bytes_out;
+    unsigned int nb_drops;          /**< non-blocking sends failed ENOSPC   */
+    unsigned int send_blocks;       /**< times a sender blocked on full     */
+    unsigned int send_ticks;        /**< total ticks senders were blocked   */
+    unsigned int send_max;          /**< longest single sender wait         */
+    unsigned int recv_blocks;       /**< times the owner blocked on empty   */
+    unsigned int recv_ticks;
+    unsigned int recv_max;
+} MBX_STAT;
+
+/* control block of a channel, shared by its producer and consumer, the
+   ring data follows it, see CHAN_DATA */
+typedef struct chan_ring {
+    volatile unsigned int head;     /**< bytes produced, producer writes   */
+    volatile unsigned int tail;     /**< bytes consumed, consumer writes   */
+    volatile unsigned char waiting; /**< CHAN_WAIT_*, kernel sets it       */
+    unsigned char chan;             /**< channel ID for the SVCs           */
+    unsigned short rsvd;
+    unsigned int size;              /**< data bytes, a power of two        */
+} CHAN_RING;
+
+
+ /*
+  *===========================================================================
+  *                            FUNCTION PROTOTYPES
+  *===========================================================================
+  */
+
+
+#endif // ! COMMON_EXT_H_
+
+ /*
+  *===========================================================================
+  *                             END OF FILE
+  *===========================================================================
+  */
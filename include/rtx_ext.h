@@ -1,53 +1,124 @@
-/*
- ****************************************************************************
- *
- *                  UNIVERSITY OF WATERLOO ECE 350 RTOS LAB  
- *
- *                     Copyright 2020-2022 Yiqing Huang
- *                          All rights reserved.
- *---------------------------------------------------------------------------
- *  Redistribution and use in source and binary forms, with or without
- *  modification, are permitted provided that the following conditions are met:
- *  - Redistributions of source code must retain the above copyright
- *    notice and the following disclaimer.
- *
- *
- *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
- *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
- *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
- *  ARE DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS AND CONTRIBUTORS BE
- *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
- *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
- *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
- *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
- *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
- *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
- *  POSSIBILITY OF SUCH DAMAGE.
- *---------------------------------------------------------------------------*/
- 
-
-/**************************************************************************//**
- * @file        rtx_ext.h 
- * @brief       RTX extended user API
- *              
- * @version     V1.2021.04
- * @authors     Yiqing Huang
- * @date        2021 APR 
- * 
- * @note        self-defined new RTX user API are declared in this file
- * @see         rtx_ext.h
- * @see         common.h
- *****************************************************************************/
- 
- /*
- *===========================================================================
- *                            FUNCTION PROTOTYPES
- *===========================================================================
- */
- 
- /*
- *===========================================================================
- *                             END OF FILE
- *===========================================================================
- */
-
+/*
+ ****************************************************************************
+ *
+ *                  UNIVERSITY OF WATERLOO ECE 350 RTOS LAB  
+ *
+ *                     Copyright 2020-2022 Yiqing Huang
+ *                          All rights reserved.
+ *---------------------------------------------------------------------------
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice and the following disclaimer.
+ *
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS AND CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *---------------------------------------------------------------------------*/
+ 
+
+/**************************************************************************//**
+ * @file        rtx_ext.h 
+ * @brief       RTX extended user API
+ *              
+ * @version     V1.2021.04
+ * @authors     Yiqing Huang
+ * @date        2021 APR 
+ * 
+ * @note        self-defined new RTX user API are declared in this file
+ * @see         rtx_ext.h
+ * @see         common.h
+ *****************************************************************************/
+ 
+#ifndef RTX_EXT_H_
+#define RTX_EXT_H_
+
+#include "common.h"
+
+ /*
+ *===========================================================================
+ *                            FUNCTION PROTOTYPES
+ *===========================================================================
+ */
+ 
+__svc(SVC_POOL_CREATE)  int     tsk_pool_create(U8 num_workers, U8 prio, U32 stack_size);
+__svc(SVC_POOL_SUBMIT)  int     tsk_pool_submit(int pool_id, void (*func)(void *), void *arg);
+__svc(SVC_POOL_TAKE)    int     tsk_pool_take(int pool_id, POOL_JOB *job);
+__svc(SVC_CBS_CREATE)   int     cbs_create(TIMEVAL *budget, TIMEVAL *period);
+__svc(SVC_CBS_ATTACH)   int     cbs_attach(task_t tid, int server_id);
+__svc(SVC_RT_TSK_BUDGET) int    rt_tsk_set_budget(TIMEVAL *wcet);
+__svc(SVC_MSG_ALLOC)    void   *msg_alloc(size_t size);
+__svc(SVC_MSG_FREE)     int     msg_free(void *msg);
+__svc(SVC_MBX_SEND_ZC)  int     send_msg_zc(task_t receiver_tid, void *msg);
+__svc(SVC_MBX_RECV_ZC)  int     recv_msg_zc(void **p_msg);
+__svc(SVC_MBX_CREATE_EX)    mbx_t   mbx_create_ex(size_t size);
+__svc(SVC_MBX_DELETE)       int     mbx_delete(mbx_t mbx);
+__svc(SVC_MBX_SEND_TO)      int     send_msg_mbx(mbx_t mbx, const void *buf);
+__svc(SVC_MBX_SEND_TO_NB)   int     send_msg_mbx_nb(mbx_t mbx, const void *buf);
+__svc(SVC_MBX_RECV_FROM)    int     recv_msg_mbx(mbx_t mbx, void *buf, size_t len);
+__svc(SVC_MBX_RECV_FROM_NB) int     recv_msg_mbx_nb(mbx_t mbx, void *buf, size_t len);
+__svc(SVC_MBX_SEND_TMO)     int     send_msg_timeout(task_t tid, const void *buf, TIMEVAL *tv);
+__svc(SVC_MBX_RECV_TMO)     int     recv_msg_timeout(void *buf, size_t len, TIMEVAL *tv);
+__svc(SVC_MBX_SELECT)       int     mbx_select(mbx_t *handles, int n, TIMEVAL *tv);
+__svc(SVC_MBX_SET_MODE)     int     mbx_set_mode(mbx_t mbx, int mode);
+__svc(SVC_MBX_SEND_BATCH)   int     send_msg_batch(task_t tid, const void *buf, int count);
+__svc(SVC_MBX_RECV_BATCH)   int     recv_msg_batch(void *buf, size_t len, int max);
+__svc(SVC_TOPIC_SUB)        int     topic_subscribe(int topic, mbx_t mbx, int policy);
+__svc(SVC_TOPIC_UNSUB)      int     topic_unsubscribe(int topic, mbx_t mbx);
+__svc(SVC_TOPIC_PUB)        int     topic_publish(int topic, const void *buf);
+__svc(SVC_MSG_CALL)         int     msg_call(task_t server, const void *req, void *reply_buf, size_t len);
+__svc(SVC_MSG_REPLY)        int     msg_reply(task_t client, const void *reply);
+__svc(SVC_UART_GETC)        int     uart_getc(void);
+__svc(SVC_UART_SELECT)      int     uart_select(mbx_t mbx);
+__svc(SVC_TSK_NOTIFY)       int     tsk_notify(task_t tid, U32 bits, int action);
+__svc(SVC_TSK_NOTIFY_WAIT)  U32     tsk_notify_wait(U32 mask, TIMEVAL *timeout);
+__svc(SVC_SEM_CREATE)       int     sem_create(int count);
+__svc(SVC_SEM_WAIT)         int     sem_wait(int sem, TIMEVAL *timeout);
+__svc(SVC_SEM_POST)         int     sem_post(int sem);
+__svc(SVC_MUTEX_CREATE)     int     mutex_create(void);
+__svc(SVC_MUTEX_LOCK)       int     mutex_lock(int mutex);
+__svc(SVC_MUTEX_UNLOCK)     int     mutex_unlock(int mutex);
+__svc(SVC_FUTEX_WAIT)       int     futex_wait(volatile U32 *addr, U32 val);
+__svc(SVC_FUTEX_WAKE)       int     futex_wake(volatile U32 *addr, int n);
+__svc(SVC_EVT_CREATE)       int     evt_create(void);
+__svc(SVC_EVT_SET)          int     evt_set(int grp, U32 bits);
+__svc(SVC_EVT_CLEAR)        int     evt_clear(int grp, U32 bits);
+__svc(SVC_EVT_WAIT)         U32     evt_wait(int grp, U32 mask, int opts, TIMEVAL *timeout);
+__svc(SVC_MSGPOOL_CREATE)   int     msgpool_create(size_t blk_size, int num);
+__svc(SVC_MSGPOOL_GET)      void   *msgpool_get(int pool, TIMEVAL *timeout);
+__svc(SVC_MSGPOOL_PUT)      int     msgpool_put(int pool, void *blk);
+__svc(SVC_MSGPOOL_DELETE)   int     msgpool_delete(int pool);
+__svc(SVC_MBX_PEEK)         int     mbx_peek(mbx_t mbx, RTX_MSG_HDR *hdr);
+__svc(SVC_MBX_RECV_TYPE)    int     recv_msg_type(U32 type_mask, void *buf, size_t len, TIMEVAL *tv);
+__svc(SVC_MBX_STAT)         int     mbx_stat(mbx_t mbx, MBX_STAT *buf);
+__svc(SVC_CHAN_CREATE)      int     chan_create(size_t size, task_t producer, task_t consumer);
+__svc(SVC_CHAN_OPEN)        CHAN_RING *chan_open(int chan);
+__svc(SVC_CHAN_WAIT)        int     chan_wait(int chan, TIMEVAL *timeout);
+__svc(SVC_CHAN_WAKE)        int     chan_wake(int chan);
+__svc(SVC_CHAN_DELETE)      int     chan_delete(int chan);
+
+/* futex locks taken without a kernel entry when uncontended, libu/futex.c */
+void    futex_lock  (volatile U32 *futex);
+void    futex_unlock(volatile U32 *futex);
+
+/* shared-memory channel streaming, libu/chan.c */
+int     chan_write  (CHAN_RING *ring, const void *buf, size_t n);
+int     chan_read   (CHAN_RING *ring, void *buf, size_t n);
+
+#endif // ! RTX_EXT_H_
+
+ /*
+ *===========================================================================
+ *                             END OF FILE
+ *===========================================================================
+ */
+